@@ -0,0 +1,351 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Analytics/GraphCentralityAnalyzer.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+
+#include <atomic>
+
+// Everything the background estimation needs, shared with the worker threads so it outlives a cancelled or destroyed analyzer
+struct FGraphCentralityTask
+{
+	// Adjacency snapshot in compressed sparse row layout, neighbours of vertex V are [FirstNeighbour[V], FirstNeighbour[V + 1])
+	TArray<int32> FirstNeighbour;
+	TArray<int32> Neighbours;
+
+	TArray<int32> Sources;
+
+	bool bComputeBetweenness = false;
+	bool bComputeCloseness = false;
+
+	// Absolute FPlatformTime::Seconds() after which no new sources are started, zero if unlimited
+	double Deadline = 0.0;
+
+	std::atomic<bool> bCancelled = false;
+
+	// Results
+	TArray<float> Betweenness;
+	TArray<float> Closeness;
+	int32 NumSampled = 0;
+
+	void Run();
+};
+
+namespace
+{
+	// Accumulators and BFS state of a single worker, merged after all workers are done so they never have to synchronize
+	struct FCentralityWorker
+	{
+		TArray<double> Betweenness;
+		TArray<double> Closeness;
+		int32 NumSampled = 0;
+
+		TArray<int32> Distances;
+		TArray<double> PathCounts;
+		TArray<double> Dependencies;
+		TArray<int32> Order;
+
+		void Init(const int32 NumVertices)
+		{
+			Betweenness.SetNumZeroed(NumVertices);
+			Closeness.SetNumZeroed(NumVertices);
+			Distances.Init(INDEX_NONE, NumVertices);
+			PathCounts.SetNumZeroed(NumVertices);
+			Dependencies.SetNumZeroed(NumVertices);
+		}
+
+		// Single source step of Brandes' algorithm, a BFS counting shortest paths followed by accumulating dependencies in reverse
+		void RunSource(const FGraphCentralityTask& Task, const int32 Source)
+		{
+			const TArray<int32>& FirstNeighbour = Task.FirstNeighbour;
+			const TArray<int32>& Neighbours = Task.Neighbours;
+
+			// Order doubles as the BFS queue and as the stack of vertices in order of non-decreasing distance
+			Order.Reset();
+			Order.Add(Source);
+			Distances[Source] = 0;
+			PathCounts[Source] = 1.0;
+
+			for (int32 Head = 0; Head < Order.Num(); ++Head)
+			{
+				const int32 V = Order[Head];
+				for (int32 Index = FirstNeighbour[V]; Index < FirstNeighbour[V + 1]; ++Index)
+				{
+					const int32 W = Neighbours[Index];
+					if (Distances[W] == INDEX_NONE)
+					{
+						Distances[W] = Distances[V] + 1;
+						Order.Add(W);
+					}
+					if (Distances[W] == Distances[V] + 1)
+					{
+						PathCounts[W] += PathCounts[V];
+					}
+				}
+			}
+
+			if (Task.bComputeCloseness)
+			{
+				for (int32 Index = 1; Index < Order.Num(); ++Index)
+				{
+					Closeness[Order[Index]] += 1.0 / Distances[Order[Index]];
+				}
+			}
+
+			if (Task.bComputeBetweenness)
+			{
+				for (int32 Index = Order.Num() - 1; Index > 0; --Index)
+				{
+					const int32 W = Order[Index];
+					const double Factor = (1.0 + Dependencies[W]) / PathCounts[W];
+					for (int32 NeighbourIndex = FirstNeighbour[W]; NeighbourIndex < FirstNeighbour[W + 1]; ++NeighbourIndex)
+					{
+						const int32 V = Neighbours[NeighbourIndex];
+						if (Distances[V] == Distances[W] - 1)
+						{
+							Dependencies[V] += PathCounts[V] * Factor;
+						}
+					}
+					Betweenness[W] += Dependencies[W];
+				}
+			}
+
+			// Only reset what this source touched, keeps each step proportional to the size of its component
+			for (const int32 V : Order)
+			{
+				Distances[V] = INDEX_NONE;
+				PathCounts[V] = 0.0;
+				Dependencies[V] = 0.0;
+			}
+		}
+	};
+}
+
+void FGraphCentralityTask::Run()
+{
+	const int32 NumVertices = FirstNeighbour.Num() - 1;
+	Betweenness.SetNumZeroed(NumVertices);
+	Closeness.SetNumZeroed(NumVertices);
+	if (Sources.IsEmpty())
+	{
+		return;
+	}
+
+	// Sources are dealt out round-robin to a fixed number of workers, each with its own accumulators
+	const int32 NumWorkers = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1, Sources.Num());
+	TArray<FCentralityWorker> Workers;
+	Workers.SetNum(NumWorkers);
+
+	ParallelFor(NumWorkers, [&](const int32 WorkerIndex)
+	{
+		FCentralityWorker& Worker = Workers[WorkerIndex];
+		Worker.Init(NumVertices);
+
+		for (int32 SampleIndex = WorkerIndex; SampleIndex < Sources.Num(); SampleIndex += NumWorkers)
+		{
+			if (bCancelled || (Deadline > 0.0 && FPlatformTime::Seconds() > Deadline))
+			{
+				break;
+			}
+			Worker.RunSource(*this, Sources[SampleIndex]);
+			++Worker.NumSampled;
+		}
+	});
+
+	TArray<double> TotalBetweenness;
+	TotalBetweenness.SetNumZeroed(NumVertices);
+	TArray<double> TotalCloseness;
+	TotalCloseness.SetNumZeroed(NumVertices);
+	for (const FCentralityWorker& Worker : Workers)
+	{
+		NumSampled += Worker.NumSampled;
+		for (int32 V = 0; V < NumVertices; ++V)
+		{
+			TotalBetweenness[V] += Worker.Betweenness[V];
+			TotalCloseness[V] += Worker.Closeness[V];
+		}
+	}
+	if (NumSampled == 0)
+	{
+		return;
+	}
+
+	// Scale the sampled sums up to all sources. Every unordered pair is seen from both ends when all sources are used, so betweenness
+	// is halved to match the exact undirected value. Closeness is normalized by the number of other vertices
+	const double SampleScale = static_cast<double>(NumVertices) / NumSampled;
+	const double ClosenessScale = NumVertices > 1 ? SampleScale / (NumVertices - 1) : 0.0;
+	for (int32 V = 0; V < NumVertices; ++V)
+	{
+		Betweenness[V] = static_cast<float>(TotalBetweenness[V] * SampleScale * 0.5);
+		Closeness[V] = static_cast<float>(TotalCloseness[V] * ClosenessScale);
+	}
+}
+
+void UGraphCentralityAnalyzer::CompleteEstimation()
+{
+	check(IsInGameThread());
+	check(RunningTask.IsValid());
+
+	if (IsValid(RunningGraph))
+	{
+		if (RunningTask->bComputeBetweenness)
+		{
+			WriteScores(RunningBetweennessAttribute, RunningTask->Betweenness);
+		}
+		if (RunningTask->bComputeCloseness)
+		{
+			WriteScores(RunningClosenessAttribute, RunningTask->Closeness);
+		}
+	}
+
+	const int32 NumSampled = RunningTask->NumSampled;
+	RunningTask.Reset();
+	RunningGraph = nullptr;
+	SnapshotVertices.Empty();
+
+	OnCompleted.Broadcast(NumSampled);
+}
+
+void UGraphCentralityAnalyzer::WriteScores(const FName Attribute, const TArray<float>& Scores)
+{
+	// The attribute may have been removed while the estimation was running
+	if (!RunningGraph->GetVertexAttributes().HasColumn(Attribute, EGraphAttributeType::Float) &&
+		!RunningGraph->AddVertexAttribute(Attribute, EGraphAttributeType::Float))
+	{
+		return;
+	}
+
+	const TArrayView<float> Column = RunningGraph->GetVertexAttributes().GetColumn<float>(Attribute);
+	for (int32 SnapshotId = 0; SnapshotId < SnapshotVertices.Num(); ++SnapshotId)
+	{
+		const UGraphStructureVertex* Vertex = SnapshotVertices[SnapshotId];
+		if (RunningGraph->ContainsVertex(Vertex))
+		{
+			Column[Vertex->GraphId] = Scores[SnapshotId];
+		}
+	}
+}
+
+void UGraphCentralityAnalyzer::BeginDestroy()
+{
+	Cancel();
+
+	Super::BeginDestroy();
+}
+
+bool UGraphCentralityAnalyzer::EstimateCentrality(UGraphStructure* Graph, FName BetweennessAttribute, FName ClosenessAttribute,
+                                                  float Epsilon, float TimeBudgetSeconds, int32 Seed)
+{
+	if (IsRunning())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UGraphCentralityAnalyzer::EstimateCentrality() called while an estimation is already running"));
+		return false;
+	}
+	if (!ensure(Graph != nullptr) || !ensure(Epsilon > 0.0f) || !ensure(!BetweennessAttribute.IsNone() || !ClosenessAttribute.IsNone()))
+	{
+		return false;
+	}
+
+	for (const FName Attribute : {BetweennessAttribute, ClosenessAttribute})
+	{
+		if (Attribute.IsNone() || Graph->GetVertexAttributes().HasColumn(Attribute, EGraphAttributeType::Float))
+		{
+			continue;
+		}
+		if (!ensureMsgf(Graph->AddVertexAttribute(Attribute, EGraphAttributeType::Float), TEXT("Vertex attribute %s is not a float attribute"),
+		                *Attribute.ToString()))
+		{
+			return false;
+		}
+	}
+
+	TSharedPtr<FGraphCentralityTask> Task = MakeShared<FGraphCentralityTask>();
+	Task->bComputeBetweenness = !BetweennessAttribute.IsNone();
+	Task->bComputeCloseness = !ClosenessAttribute.IsNone();
+
+	// Snapshot the adjacency, self-loops never lie on a shortest path
+	const TConstArrayView<UGraphStructureVertex*> Vertices = Graph->GetVertexArray();
+	const int32 NumVertices = Vertices.Num();
+	Task->FirstNeighbour.SetNumUninitialized(NumVertices + 1);
+	Task->Neighbours.Reserve(Graph->GetNumEdges() * 2);
+	for (int32 VertexId = 0; VertexId < NumVertices; ++VertexId)
+	{
+		const UGraphStructureVertex* Vertex = Vertices[VertexId];
+		Task->FirstNeighbour[VertexId] = Task->Neighbours.Num();
+		for (const UGraphStructureEdge* Edge : Vertex->Adjacency)
+		{
+			const UGraphStructureVertex* Neighbour = Edge->Source == Vertex ? Edge->Target : Edge->Source;
+			if (Neighbour != Vertex)
+			{
+				Task->Neighbours.Add(Neighbour->GraphId);
+			}
+		}
+	}
+	Task->FirstNeighbour[NumVertices] = Task->Neighbours.Num();
+
+	// Computed in double and clamped before converting, small epsilons would overflow int32
+	const double RequiredSamples = NumVertices > 1 ? FMath::Loge(static_cast<double>(NumVertices)) / (static_cast<double>(Epsilon) * Epsilon) : NumVertices;
+	const int32 NumSamples = static_cast<int32>(FMath::Min(FMath::CeilToDouble(RequiredSamples), static_cast<double>(NumVertices)));
+
+	// Sample sources without replacement using a partial Fisher-Yates shuffle
+	TArray<int32> Candidates;
+	Candidates.SetNumUninitialized(NumVertices);
+	for (int32 VertexId = 0; VertexId < NumVertices; ++VertexId)
+	{
+		Candidates[VertexId] = VertexId;
+	}
+	FRandomStream RandomStream(Seed);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		Candidates.Swap(Index, RandomStream.RandRange(Index, NumVertices - 1));
+	}
+	Candidates.SetNum(NumSamples);
+	Task->Sources = MoveTemp(Candidates);
+
+	if (TimeBudgetSeconds > 0.0f)
+	{
+		Task->Deadline = FPlatformTime::Seconds() + TimeBudgetSeconds;
+	}
+
+	RunningGraph = Graph;
+	SnapshotVertices = TArray<UGraphStructureVertex*>(Vertices);
+	RunningBetweennessAttribute = BetweennessAttribute;
+	RunningClosenessAttribute = ClosenessAttribute;
+	RunningTask = Task;
+
+	Async(EAsyncExecution::ThreadPool, [Task, WeakThis = TWeakObjectPtr<UGraphCentralityAnalyzer>(this)]()
+	{
+		Task->Run();
+
+		AsyncTask(ENamedThreads::GameThread, [Task, WeakThis]()
+		{
+			// A cancelled task has been replaced or cleared in the meantime
+			UGraphCentralityAnalyzer* Analyzer = WeakThis.Get();
+			if (Analyzer != nullptr && Analyzer->RunningTask == Task)
+			{
+				Analyzer->CompleteEstimation();
+			}
+		});
+	});
+
+	return true;
+}
+
+void UGraphCentralityAnalyzer::Cancel()
+{
+	if (RunningTask.IsValid())
+	{
+		RunningTask->bCancelled = true;
+	}
+
+	RunningTask.Reset();
+	RunningGraph = nullptr;
+	SnapshotVertices.Empty();
+}
+
+bool UGraphCentralityAnalyzer::IsRunning() const
+{
+	return RunningTask.IsValid();
+}
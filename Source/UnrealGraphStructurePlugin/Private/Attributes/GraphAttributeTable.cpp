@@ -0,0 +1,385 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Attributes/GraphAttributeTable.h"
+
+namespace
+{
+	// Floats are summed in SIMD lanes per block and the block results in double, keeping the error bounded on large columns
+	constexpr int32 SumBlockSize = 1024;
+
+	double SumFloats(TConstArrayView<float> Values)
+	{
+		double Total = 0.0;
+		for (int32 BlockStart = 0; BlockStart < Values.Num(); BlockStart += SumBlockSize)
+		{
+			const int32 BlockEnd = FMath::Min(BlockStart + SumBlockSize, Values.Num());
+			const float* Data = Values.GetData();
+
+			int32 Index = BlockStart;
+			VectorRegister4Float Accumulator = VectorZeroFloat();
+			for (; Index + 4 <= BlockEnd; Index += 4)
+			{
+				Accumulator = VectorAdd(Accumulator, VectorLoad(Data + Index));
+			}
+
+			float Lanes[4];
+			VectorStore(Accumulator, Lanes);
+			double BlockTotal = static_cast<double>(Lanes[0]) + Lanes[1] + Lanes[2] + Lanes[3];
+			for (; Index < BlockEnd; ++Index)
+			{
+				BlockTotal += Data[Index];
+			}
+			Total += BlockTotal;
+		}
+		return Total;
+	}
+
+	template <typename T>
+	void RemoveRowsSwap(TMap<FName, TArray<T>>& Columns, const int32 Row)
+	{
+		for (auto& Pair : Columns)
+		{
+			Pair.Value.RemoveAtSwap(Row, 1, EAllowShrinking::No);
+		}
+	}
+
+	template <typename T>
+	void FitRowsZeroed(TMap<FName, TArray<T>>& Columns, const int32 NumRows)
+	{
+		for (auto& Pair : Columns)
+		{
+			if (!ensureMsgf(Pair.Value.Num() == NumRows, TEXT("Attribute column %s has %d rows instead of %d"), *Pair.Key.ToString(),
+			                Pair.Value.Num(), NumRows))
+			{
+				Pair.Value.SetNumZeroed(NumRows);
+			}
+		}
+	}
+
+	template <typename T>
+	void AddRowsZeroed(TMap<FName, TArray<T>>& Columns, const int32 Count)
+	{
+		for (auto& Pair : Columns)
+		{
+			Pair.Value.AddZeroed(Count);
+		}
+	}
+}
+
+bool FGraphAttributeTable::AddColumn(const FName Name, const EGraphAttributeType Type)
+{
+	if (HasColumn(Name))
+	{
+		return false;
+	}
+
+	switch (Type)
+	{
+	case EGraphAttributeType::Float:
+		FloatColumns.Add(Name).SetNumZeroed(NumRows);
+		break;
+	case EGraphAttributeType::Int:
+		IntColumns.Add(Name).SetNumZeroed(NumRows);
+		break;
+	case EGraphAttributeType::Vector:
+		VectorColumns.Add(Name).SetNumZeroed(NumRows);
+		break;
+	case EGraphAttributeType::Bool:
+		BoolColumns.Add(Name).Init(false, NumRows);
+		break;
+	default:
+		checkNoEntry();
+		return false;
+	}
+	return true;
+}
+
+bool FGraphAttributeTable::RemoveColumn(const FName Name)
+{
+	return FloatColumns.Remove(Name) + IntColumns.Remove(Name) + VectorColumns.Remove(Name) + BoolColumns.Remove(Name) > 0;
+}
+
+bool FGraphAttributeTable::HasColumn(const FName Name) const
+{
+	return FloatColumns.Contains(Name) || IntColumns.Contains(Name) || VectorColumns.Contains(Name) || BoolColumns.Contains(Name);
+}
+
+bool FGraphAttributeTable::HasColumn(const FName Name, const EGraphAttributeType Type) const
+{
+	switch (Type)
+	{
+	case EGraphAttributeType::Float:
+		return FloatColumns.Contains(Name);
+	case EGraphAttributeType::Int:
+		return IntColumns.Contains(Name);
+	case EGraphAttributeType::Vector:
+		return VectorColumns.Contains(Name);
+	case EGraphAttributeType::Bool:
+		return BoolColumns.Contains(Name);
+	default:
+		checkNoEntry();
+		return false;
+	}
+}
+
+TBitArray<>* FGraphAttributeTable::GetBoolColumn(const FName Name)
+{
+	return BoolColumns.Find(Name);
+}
+
+const TBitArray<>* FGraphAttributeTable::GetBoolColumn(const FName Name) const
+{
+	return BoolColumns.Find(Name);
+}
+
+void FGraphAttributeTable::AddRows(const int32 Count)
+{
+	check(Count >= 0);
+
+	AddRowsZeroed(FloatColumns, Count);
+	AddRowsZeroed(IntColumns, Count);
+	AddRowsZeroed(VectorColumns, Count);
+	for (auto& Pair : BoolColumns)
+	{
+		Pair.Value.Add(false, Count);
+	}
+
+	NumRows += Count;
+}
+
+void FGraphAttributeTable::RemoveRowSwap(const int32 Row)
+{
+	check(Row >= 0 && Row < NumRows);
+
+	RemoveRowsSwap(FloatColumns, Row);
+	RemoveRowsSwap(IntColumns, Row);
+	RemoveRowsSwap(VectorColumns, Row);
+	for (auto& Pair : BoolColumns)
+	{
+		TBitArray<>& Column = Pair.Value;
+		Column[Row] = static_cast<bool>(Column[NumRows - 1]);
+		Column.RemoveAt(NumRows - 1);
+	}
+
+	--NumRows;
+}
+
+void FGraphAttributeTable::Reserve(const int32 Rows)
+{
+	for (auto& Pair : FloatColumns)
+	{
+		Pair.Value.Reserve(Rows);
+	}
+	for (auto& Pair : IntColumns)
+	{
+		Pair.Value.Reserve(Rows);
+	}
+	for (auto& Pair : VectorColumns)
+	{
+		Pair.Value.Reserve(Rows);
+	}
+	for (auto& Pair : BoolColumns)
+	{
+		Pair.Value.Reserve(Rows);
+	}
+}
+
+void FGraphAttributeTable::Shrink()
+{
+	for (auto& Pair : FloatColumns)
+	{
+		Pair.Value.Shrink();
+	}
+	for (auto& Pair : IntColumns)
+	{
+		Pair.Value.Shrink();
+	}
+	for (auto& Pair : VectorColumns)
+	{
+		Pair.Value.Shrink();
+	}
+	for (auto& Pair : BoolColumns)
+	{
+		// TBitArray has no Shrink, a copy is allocated for exactly the bits in use
+		Pair.Value = TBitArray<>(Pair.Value);
+	}
+}
+
+void FGraphAttributeTable::Reset()
+{
+	FloatColumns.Empty();
+	IntColumns.Empty();
+	VectorColumns.Empty();
+	BoolColumns.Empty();
+	NumRows = 0;
+}
+
+bool FGraphAttributeTable::SetFloatColumn(const FName Name, TConstArrayView<float> Values)
+{
+	TArray<float>* Column = FloatColumns.Find(Name);
+	if (Column == nullptr || !ensure(Values.Num() == NumRows))
+	{
+		return false;
+	}
+
+	FMemory::Memcpy(Column->GetData(), Values.GetData(), NumRows * sizeof(float));
+	return true;
+}
+
+bool FGraphAttributeTable::FillFloatColumn(const FName Name, const float Value)
+{
+	TArray<float>* Column = FloatColumns.Find(Name);
+	if (Column == nullptr)
+	{
+		return false;
+	}
+
+	for (float& Element : *Column)
+	{
+		Element = Value;
+	}
+	return true;
+}
+
+bool FGraphAttributeTable::ScaleFloatColumn(const FName Name, const float Factor)
+{
+	TArray<float>* Column = FloatColumns.Find(Name);
+	if (Column == nullptr)
+	{
+		return false;
+	}
+
+	float* Data = Column->GetData();
+	const int32 Num = Column->Num();
+	const VectorRegister4Float FactorRegister = VectorSetFloat1(Factor);
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		VectorStore(VectorMultiply(VectorLoad(Data + Index), FactorRegister), Data + Index);
+	}
+	for (; Index < Num; ++Index)
+	{
+		Data[Index] *= Factor;
+	}
+	return true;
+}
+
+double FGraphAttributeTable::SumFloatColumn(const FName Name) const
+{
+	return SumFloats(GetColumn<float>(Name));
+}
+
+bool FGraphAttributeTable::MinMaxFloatColumn(const FName Name, float& OutMin, float& OutMax) const
+{
+	const TConstArrayView<float> Column = GetColumn<float>(Name);
+	if (Column.Num() == 0)
+	{
+		return false;
+	}
+
+	const float* Data = Column.GetData();
+	const int32 Num = Column.Num();
+
+	VectorRegister4Float MinRegister = VectorSetFloat1(Data[0]);
+	VectorRegister4Float MaxRegister = MinRegister;
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const VectorRegister4Float Values = VectorLoad(Data + Index);
+		MinRegister = VectorMin(MinRegister, Values);
+		MaxRegister = VectorMax(MaxRegister, Values);
+	}
+
+	float MinLanes[4];
+	float MaxLanes[4];
+	VectorStore(MinRegister, MinLanes);
+	VectorStore(MaxRegister, MaxLanes);
+	OutMin = FMath::Min(FMath::Min(MinLanes[0], MinLanes[1]), FMath::Min(MinLanes[2], MinLanes[3]));
+	OutMax = FMath::Max(FMath::Max(MaxLanes[0], MaxLanes[1]), FMath::Max(MaxLanes[2], MaxLanes[3]));
+
+	for (; Index < Num; ++Index)
+	{
+		OutMin = FMath::Min(OutMin, Data[Index]);
+		OutMax = FMath::Max(OutMax, Data[Index]);
+	}
+	return true;
+}
+
+int64 FGraphAttributeTable::SumIntColumn(const FName Name) const
+{
+	int64 Total = 0;
+	for (const int32 Value : GetColumn<int32>(Name))
+	{
+		Total += Value;
+	}
+	return Total;
+}
+
+FVector FGraphAttributeTable::SumVectorColumn(const FName Name) const
+{
+	FVector Total = FVector::ZeroVector;
+	for (const FVector& Value : GetColumn<FVector>(Name))
+	{
+		Total += Value;
+	}
+	return Total;
+}
+
+int32 FGraphAttributeTable::CountTrue(const FName Name) const
+{
+	const TBitArray<>* Column = BoolColumns.Find(Name);
+	return Column != nullptr ? Column->CountSetBits() : 0;
+}
+
+SIZE_T FGraphAttributeTable::GetAllocatedSize() const
+{
+	SIZE_T Size = FloatColumns.GetAllocatedSize() + IntColumns.GetAllocatedSize();
+	Size += VectorColumns.GetAllocatedSize() + BoolColumns.GetAllocatedSize();
+	for (const auto& Pair : FloatColumns)
+	{
+		Size += Pair.Value.GetAllocatedSize();
+	}
+	for (const auto& Pair : IntColumns)
+	{
+		Size += Pair.Value.GetAllocatedSize();
+	}
+	for (const auto& Pair : VectorColumns)
+	{
+		Size += Pair.Value.GetAllocatedSize();
+	}
+	for (const auto& Pair : BoolColumns)
+	{
+		Size += Pair.Value.GetAllocatedSize();
+	}
+	return Size;
+}
+
+FArchive& operator<<(FArchive& Ar, FGraphAttributeTable& Table)
+{
+	Ar << Table.NumRows;
+	Ar << Table.FloatColumns;
+	Ar << Table.IntColumns;
+	Ar << Table.VectorColumns;
+	Ar << Table.BoolColumns;
+
+	if (Ar.IsLoading())
+	{
+		Table.NumRows = FMath::Max(Table.NumRows, 0);
+		FitRowsZeroed(Table.FloatColumns, Table.NumRows);
+		FitRowsZeroed(Table.IntColumns, Table.NumRows);
+		FitRowsZeroed(Table.VectorColumns, Table.NumRows);
+		for (auto& Pair : Table.BoolColumns)
+		{
+			TBitArray<>& Column = Pair.Value;
+			if (!ensureMsgf(Column.Num() == Table.NumRows, TEXT("Attribute column %s has %d rows instead of %d"), *Pair.Key.ToString(),
+			                Column.Num(), Table.NumRows))
+			{
+				Column.SetNum(Table.NumRows, false);
+			}
+		}
+	}
+	return Ar;
+}
@@ -3,7 +3,300 @@
 
 #include "ConnectedComponents/GraphConnectedComponent.h"
 
+#include "ConnectedComponents/GraphConnectedComponentsMonitor.h"
+
+void FGraphComponentAggregate::Add(const float Value)
+{
+	if (Count == 0)
+	{
+		Min = Value;
+		Max = Value;
+		MinCount = 0;
+		MaxCount = 0;
+	}
+
+	Sum += Value;
+	++Count;
+
+	if (Value < Min)
+	{
+		Min = Value;
+		MinCount = 0;
+	}
+	if (Value > Max)
+	{
+		Max = Value;
+		MaxCount = 0;
+	}
+	MinCount += Value == Min ? 1 : 0;
+	MaxCount += Value == Max ? 1 : 0;
+}
+
+bool FGraphComponentAggregate::Remove(const float Value)
+{
+	check(Count > 0);
+
+	--Count;
+	if (Count == 0)
+	{
+		*this = FGraphComponentAggregate();
+		return true;
+	}
+	Sum -= Value;
+
+	MinCount -= Value == Min ? 1 : 0;
+	MaxCount -= Value == Max ? 1 : 0;
+	return MinCount > 0 && MaxCount > 0;
+}
+
+void FGraphComponentAggregate::Combine(const FGraphComponentAggregate& Other)
+{
+	if (Other.Count == 0)
+	{
+		return;
+	}
+	if (Count == 0)
+	{
+		*this = Other;
+		return;
+	}
+
+	Sum += Other.Sum;
+	Count += Other.Count;
+
+	if (Other.Min < Min)
+	{
+		Min = Other.Min;
+		MinCount = Other.MinCount;
+	}
+	else if (Other.Min == Min)
+	{
+		MinCount += Other.MinCount;
+	}
+
+	if (Other.Max > Max)
+	{
+		Max = Other.Max;
+		MaxCount = Other.MaxCount;
+	}
+	else if (Other.Max == Max)
+	{
+		MaxCount += Other.MaxCount;
+	}
+}
+
+bool FGraphComponentAggregate::Subtract(const FGraphComponentAggregate& Part)
+{
+	if (Part.Count == 0)
+	{
+		return true;
+	}
+	check(Part.Count <= Count);
+
+	Count -= Part.Count;
+	if (Count == 0)
+	{
+		*this = FGraphComponentAggregate();
+		return true;
+	}
+	Sum -= Part.Sum;
+
+	// The part can't hold values beyond our extrema, only the number of extreme values can change
+	MinCount -= Part.Min == Min ? Part.MinCount : 0;
+	MaxCount -= Part.Max == Max ? Part.MaxCount : 0;
+	return MinCount > 0 && MaxCount > 0;
+}
+
+namespace
+{
+	using FHeapEntry = FGraphComponentValueHeaps::FEntry;
+
+	struct FMinHeapPredicate
+	{
+		bool operator()(const FHeapEntry& A, const FHeapEntry& B) const
+		{
+			return A.Value < B.Value;
+		}
+	};
+
+	struct FMaxHeapPredicate
+	{
+		bool operator()(const FHeapEntry& A, const FHeapEntry& B) const
+		{
+			return A.Value > B.Value;
+		}
+	};
+
+	template <typename PredicateType>
+	void AppendHeap(TArray<FHeapEntry>& Heap, TArray<FHeapEntry>&& Other, const PredicateType& Predicate)
+	{
+		if (Other.Num() > Heap.Num())
+		{
+			Swap(Heap, Other);
+		}
+		for (const FHeapEntry& Entry : Other)
+		{
+			Heap.HeapPush(Entry, Predicate);
+		}
+		Other.Empty();
+	}
+
+	// Drop stale entries from the top, then pop every current entry holding the extreme value to count them and push them back
+	template <typename PredicateType>
+	void RecoverExtreme(TArray<FHeapEntry>& Heap, TFunctionRef<bool(const FHeapEntry&)> IsCurrent, const PredicateType& Predicate,
+	                    float& OutValue, int32& OutCount)
+	{
+		TArray<FHeapEntry, TInlineAllocator<8>> ExtremeEntries;
+		while (!Heap.IsEmpty())
+		{
+			const FHeapEntry& Top = Heap.HeapTop();
+			if (IsCurrent(Top))
+			{
+				if (!ExtremeEntries.IsEmpty() && Top.Value != ExtremeEntries[0].Value)
+				{
+					break;
+				}
+				ExtremeEntries.AddUninitialized();
+				Heap.HeapPop(ExtremeEntries.Last(), Predicate, EAllowShrinking::No);
+			}
+			else
+			{
+				Heap.HeapPopDiscard(Predicate, EAllowShrinking::No);
+			}
+		}
+		check(!ExtremeEntries.IsEmpty());
+
+		OutValue = ExtremeEntries[0].Value;
+		OutCount = ExtremeEntries.Num();
+		for (const FHeapEntry& Entry : ExtremeEntries)
+		{
+			Heap.HeapPush(Entry, Predicate);
+		}
+	}
+}
+
+void FGraphComponentValueHeaps::Push(const float Value, const uint32 Stamp, UGraphStructureVertex* Vertex)
+{
+	const FEntry Entry{Value, Stamp, Vertex};
+	MinHeap.HeapPush(Entry, FMinHeapPredicate());
+	MaxHeap.HeapPush(Entry, FMaxHeapPredicate());
+}
+
+void FGraphComponentValueHeaps::Append(FGraphComponentValueHeaps&& Other)
+{
+	AppendHeap(MinHeap, MoveTemp(Other.MinHeap), FMinHeapPredicate());
+	AppendHeap(MaxHeap, MoveTemp(Other.MaxHeap), FMaxHeapPredicate());
+}
+
+void FGraphComponentValueHeaps::RecoverExtrema(TFunctionRef<bool(const FEntry&)> IsCurrent, FGraphComponentAggregate& Aggregate)
+{
+	check(Aggregate.Count > 0);
+
+	RecoverExtreme(MinHeap, IsCurrent, FMinHeapPredicate(), Aggregate.Min, Aggregate.MinCount);
+	RecoverExtreme(MaxHeap, IsCurrent, FMaxHeapPredicate(), Aggregate.Max, Aggregate.MaxCount);
+}
+
+void FGraphComponentValueHeaps::CompactIfStale(TFunctionRef<bool(const FEntry&)> IsCurrent, const int32 NumCurrent)
+{
+	// Both heaps hold the same entries, so checking one of them is enough
+	if (MinHeap.Num() <= 2 * NumCurrent + 16)
+	{
+		return;
+	}
+
+	MinHeap.RemoveAllSwap([&IsCurrent](const FEntry& Entry) { return !IsCurrent(Entry); }, EAllowShrinking::No);
+	check(MinHeap.Num() == NumCurrent);
+	MaxHeap = MinHeap;
+	MinHeap.Heapify(FMinHeapPredicate());
+	MaxHeap.Heapify(FMaxHeapPredicate());
+}
+
+void FGraphComponentValueHeaps::Reset()
+{
+	MinHeap.Reset();
+	MaxHeap.Reset();
+}
+
+void FGraphComponentValueHeaps::Shrink()
+{
+	MinHeap.Shrink();
+	MaxHeap.Shrink();
+}
+
+SIZE_T FGraphComponentValueHeaps::GetAllocatedSize() const
+{
+	return MinHeap.GetAllocatedSize() + MaxHeap.GetAllocatedSize();
+}
+
+void UGraphConnectedComponent::ResolvePendingSplits()
+{
+	// Components are always created by their monitor, which might hold back splits in lazy mode
+	if (UGraphConnectedComponentsMonitor* Monitor = Cast<UGraphConnectedComponentsMonitor>(GetOuter()))
+	{
+		Monitor->ResolvePendingSplits();
+	}
+}
+
+void UGraphConnectedComponent::Shrink()
+{
+	Vertices.Compact();
+	Vertices.Shrink();
+	Aggregates.Compact();
+	Aggregates.Shrink();
+	for (auto& Pair : ValueHeaps)
+	{
+		Pair.Value.Shrink();
+	}
+}
+
+void UGraphConnectedComponent::OnCreated_Implementation()
+{
+}
+
+void UGraphConnectedComponent::OnDestroyed_Implementation()
+{
+}
+
+void UGraphConnectedComponent::OnVertexAdded_Implementation(UGraphStructureVertex* Vertex)
+{
+}
+
+void UGraphConnectedComponent::OnVertexRemoved_Implementation(UGraphStructureVertex* Vertex)
+{
+}
+
+void UGraphConnectedComponent::OnChanged_Implementation(const FGraphConnectedComponentDiff& Diff)
+{
+}
+
 TSet<UGraphStructureVertex*> UGraphConnectedComponent::GetVertices()
 {
+	ResolvePendingSplits();
+
 	return Vertices;
 }
+
+FGraphComponentAggregate UGraphConnectedComponent::GetAggregate(FName Channel)
+{
+	ResolvePendingSplits();
+
+	const FGraphComponentAggregate* Aggregate = Aggregates.Find(Channel);
+	return Aggregate != nullptr ? *Aggregate : FGraphComponentAggregate();
+}
+
+SIZE_T UGraphConnectedComponent::GetAllocatedSize() const
+{
+	SIZE_T Size = Vertices.GetAllocatedSize() + Aggregates.GetAllocatedSize() + ValueHeaps.GetAllocatedSize();
+	for (const auto& Pair : ValueHeaps)
+	{
+		Size += Pair.Value.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void UGraphConnectedComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetAllocatedSize());
+}
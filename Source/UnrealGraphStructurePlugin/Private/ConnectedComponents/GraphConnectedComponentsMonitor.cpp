@@ -3,10 +3,18 @@
 
 #include "ConnectedComponents/GraphConnectedComponentsMonitor.h"
 
+#include "Misc/CoreDelegates.h"
+
 UGraphConnectedComponent* UGraphConnectedComponentsMonitor::ConnectedComponent_Spawn()
 {
 	UGraphConnectedComponent* NewConnectedComponent = NewObject<UGraphConnectedComponent>(this, ConnectedComponentClass);
 
+	if (bCoalesceEvents)
+	{
+		PendingChanges.FindOrAdd(NewConnectedComponent).bCreated = true;
+		return NewConnectedComponent;
+	}
+
 	NewConnectedComponent->OnCreated();
 
 	return NewConnectedComponent;
@@ -17,6 +25,14 @@ void UGraphConnectedComponentsMonitor::ConnectedComponent_Destroy(UGraphConnecte
 	check(ConnectedComponent != nullptr);
 	check(ConnectedComponent->Vertices.IsEmpty());
 
+	PendingSplits.Remove(ConnectedComponent);
+
+	if (bCoalesceEvents)
+	{
+		PendingChanges.FindOrAdd(ConnectedComponent).bDestroyed = true;
+		return;
+	}
+
 	ConnectedComponent->OnDestroyed();
 }
 
@@ -29,6 +45,16 @@ void UGraphConnectedComponentsMonitor::ConnectedComponent_AddVertex(UGraphConnec
 
 	ConnectedComponent->Vertices.Add(Vertex);
 
+	if (bCoalesceEvents)
+	{
+		FGraphComponentChangeRecord& ChangeRecord = PendingChanges.FindOrAdd(ConnectedComponent);
+		if (ChangeRecord.RemovedVertices.Remove(Vertex) == 0)
+		{
+			ChangeRecord.AddedVertices.Add(Vertex);
+		}
+		return;
+	}
+
 	ConnectedComponent->OnVertexAdded(Vertex);
 }
 
@@ -41,9 +67,288 @@ void UGraphConnectedComponentsMonitor::ConnectedComponent_RemoveVertex(UGraphCon
 
 	ConnectedComponent->Vertices.Remove(Vertex);
 
+	if (bCoalesceEvents)
+	{
+		FGraphComponentChangeRecord& ChangeRecord = PendingChanges.FindOrAdd(ConnectedComponent);
+		if (ChangeRecord.AddedVertices.Remove(Vertex) == 0)
+		{
+			ChangeRecord.RemovedVertices.Add(Vertex);
+		}
+		return;
+	}
+
 	ConnectedComponent->OnVertexRemoved(Vertex);
 }
 
+void UGraphConnectedComponentsMonitor::ConnectedComponent_MoveVertices(UGraphConnectedComponent* FromConnectedComponent,
+                                                                       UGraphConnectedComponent* ToConnectedComponent,
+                                                                       const TSet<UGraphStructureVertex*>& MoveVertices)
+{
+	check(FromConnectedComponent != nullptr);
+	check(ToConnectedComponent != nullptr);
+	check(FromConnectedComponent != ToConnectedComponent);
+
+	const bool bMoveWholeComponent = MoveVertices.Num() == FromConnectedComponent->Vertices.Num();
+
+	// A merged component that still has to be checked for splits passes that on to the component it is merged into
+	FGraphPendingSplit PendingSplit;
+	if (bMoveWholeComponent && PendingSplits.RemoveAndCopyValue(FromConnectedComponent, PendingSplit))
+	{
+		PendingSplits.FindOrAdd(ToConnectedComponent).StartVertices.Append(PendingSplit.StartVertices);
+	}
+
+	if (bCoalesceEvents)
+	{
+		if (bMoveWholeComponent)
+		{
+			PendingChanges.FindOrAdd(ToConnectedComponent).MergedFrom.Add(FromConnectedComponent);
+		}
+		else
+		{
+			PendingChanges.FindOrAdd(FromConnectedComponent).SplitInto.Add(ToConnectedComponent);
+		}
+	}
+
+	for (const auto& ChannelPair : AggregateChannels)
+	{
+		const FName Channel = ChannelPair.Key;
+		FGraphComponentAggregate* FromAggregate = FromConnectedComponent->Aggregates.Find(Channel);
+		if (FromAggregate == nullptr || FromAggregate->Count == 0)
+		{
+			continue;
+		}
+
+		if (bMoveWholeComponent)
+		{
+			// Merging, combine aggregates and value heaps directly, all heap entries stay current
+			ToConnectedComponent->Aggregates.FindOrAdd(Channel).Combine(*FromAggregate);
+			*FromAggregate = FGraphComponentAggregate();
+
+			ToConnectedComponent->ValueHeaps.FindOrAdd(Channel).Append(MoveTemp(FromConnectedComponent->ValueHeaps.FindChecked(Channel)));
+			FromConnectedComponent->ValueHeaps.Remove(Channel);
+			continue;
+		}
+
+		// Splitting, only the moved vertices have to be visited. Their new stamps leave the old entries in the heaps of the
+		// remaining part stale
+		FGraphComponentAggregate MovedAggregate;
+		for (UGraphStructureVertex* MoveVertex : MoveVertices)
+		{
+			if (const float* Value = ChannelPair.Value.VertexValues.Find(MoveVertex))
+			{
+				MovedAggregate.Add(*Value);
+				Aggregate_PushValue(ToConnectedComponent, Channel, MoveVertex, *Value);
+			}
+		}
+		if (MovedAggregate.Count == 0)
+		{
+			continue;
+		}
+
+		ToConnectedComponent->Aggregates.FindOrAdd(Channel).Combine(MovedAggregate);
+		const bool bExtremaKept = FromAggregate->Subtract(MovedAggregate);
+		Aggregate_UpdateHeaps(FromConnectedComponent, Channel, !bExtremaKept);
+	}
+
+	for (UGraphStructureVertex* MoveVertex : MoveVertices)
+	{
+		ConnectedComponent_RemoveVertex(FromConnectedComponent, MoveVertex);
+		ConnectedComponent_AddVertex(ToConnectedComponent, MoveVertex);
+		VerticesComponentsMap.Add(MoveVertex, ToConnectedComponent);
+	}
+}
+
+void UGraphConnectedComponentsMonitor::ConnectedComponent_SplitDisconnected(UGraphConnectedComponent* ConnectedComponent,
+                                                                            const TArray<UGraphStructureVertex*>& StartVertices)
+{
+	check(ConnectedComponent != nullptr);
+
+	// Searches are merged using union-find, the root of each set owns the queue of the merged search
+	struct FSearch
+	{
+		TArray<UGraphStructureVertex*> Queue;
+		int32 QueueIndex = 0;
+	};
+
+	TArray<FSearch> Searches;
+	TArray<int32> Parents;
+	TMap<UGraphStructureVertex*, int32> DiscoveredBy;
+	TArray<int32> OpenSearches;
+
+	for (UGraphStructureVertex* StartVertex : StartVertices)
+	{
+		check(ConnectedComponent->Vertices.Contains(StartVertex));
+		if (DiscoveredBy.Contains(StartVertex))
+		{
+			continue;
+		}
+
+		const int32 Search = Searches.AddDefaulted();
+		Searches[Search].Queue.Add(StartVertex);
+		Parents.Add(Search);
+		DiscoveredBy.Add(StartVertex, Search);
+		OpenSearches.Add(Search);
+	}
+
+	auto FindRoot = [&](int32 Search) -> int32
+	{
+		while (Parents[Search] != Search)
+		{
+			Parents[Search] = Parents[Parents[Search]];
+			Search = Parents[Search];
+		}
+		return Search;
+	};
+
+	TArray<int32> FinishedSearches;
+	int32 NextOpenSearch = 0;
+	while (OpenSearches.Num() > 1)
+	{
+		if (NextOpenSearch >= OpenSearches.Num())
+		{
+			NextOpenSearch = 0;
+		}
+
+		int32 CurrentSearch = OpenSearches[NextOpenSearch];
+		if (Searches[CurrentSearch].QueueIndex == Searches[CurrentSearch].Queue.Num())
+		{
+			// Nothing left to explore, this search found a complete component
+			OpenSearches.RemoveAtSwap(NextOpenSearch);
+			FinishedSearches.Add(CurrentSearch);
+			continue;
+		}
+
+		UGraphStructureVertex* NextVertex = Searches[CurrentSearch].Queue[Searches[CurrentSearch].QueueIndex++];
+		check(NextVertex != nullptr);
+
+		for (const UGraphStructureEdge* Edge : NextVertex->Adjacency)
+		{
+			check(Edge != nullptr);
+			UGraphStructureVertex* Neighbour = Edge->Source == NextVertex ? Edge->Target : Edge->Source;
+
+			if (const int32* NeighbourSearch = DiscoveredBy.Find(Neighbour))
+			{
+				const int32 OtherSearch = FindRoot(*NeighbourSearch);
+				if (OtherSearch == CurrentSearch)
+				{
+					continue;
+				}
+
+				// Two searches met, continue them as one using the bigger queue
+				FSearch& Current = Searches[CurrentSearch];
+				FSearch& Other = Searches[OtherSearch];
+				const bool bKeepCurrent = Current.Queue.Num() - Current.QueueIndex >= Other.Queue.Num() - Other.QueueIndex;
+				const int32 KeepSearch = bKeepCurrent ? CurrentSearch : OtherSearch;
+				const int32 AbsorbSearch = bKeepCurrent ? OtherSearch : CurrentSearch;
+
+				FSearch& Keep = Searches[KeepSearch];
+				FSearch& Absorb = Searches[AbsorbSearch];
+				for (int32 QueueIndex = Absorb.QueueIndex; QueueIndex < Absorb.Queue.Num(); ++QueueIndex)
+				{
+					Keep.Queue.Add(Absorb.Queue[QueueIndex]);
+				}
+				Absorb.Queue.Empty();
+				Absorb.QueueIndex = 0;
+
+				Parents[AbsorbSearch] = KeepSearch;
+				OpenSearches.RemoveSingleSwap(AbsorbSearch);
+				CurrentSearch = KeepSearch;
+			}
+			else
+			{
+				DiscoveredBy.Add(Neighbour, CurrentSearch);
+				Searches[CurrentSearch].Queue.Add(Neighbour);
+			}
+		}
+
+		++NextOpenSearch;
+	}
+
+	if (FinishedSearches.IsEmpty())
+	{
+		return;
+	}
+
+	// Every finished search becomes a new component, the remaining open search keeps the existing one
+
+	TMap<int32, TSet<UGraphStructureVertex*>> SplitOffVertices;
+	for (const int32 FinishedSearch : FinishedSearches)
+	{
+		SplitOffVertices.Add(FinishedSearch);
+	}
+	for (const auto& Pair : DiscoveredBy)
+	{
+		if (TSet<UGraphStructureVertex*>* SplitOffSet = SplitOffVertices.Find(FindRoot(Pair.Value)))
+		{
+			SplitOffSet->Add(Pair.Key);
+		}
+	}
+
+	for (const auto& Pair : SplitOffVertices)
+	{
+		UGraphConnectedComponent* NewConnectedComponent = ConnectedComponent_Spawn();
+		ConnectedComponent_MoveVertices(ConnectedComponent, NewConnectedComponent, Pair.Value);
+	}
+}
+
+void UGraphConnectedComponentsMonitor::ConnectedComponent_HandleEdgesRemoved(UGraphConnectedComponent* ConnectedComponent,
+                                                                             const TArray<UGraphStructureVertex*>& StartVertices)
+{
+	if (bLazyMode)
+	{
+		PendingSplits.FindOrAdd(ConnectedComponent).StartVertices.Append(StartVertices);
+		return;
+	}
+
+	ConnectedComponent_SplitDisconnected(ConnectedComponent, StartVertices);
+}
+
+void UGraphConnectedComponentsMonitor::Aggregate_PushValue(UGraphConnectedComponent* ConnectedComponent, FName Channel,
+                                                           UGraphStructureVertex* Vertex, float Value)
+{
+	check(ConnectedComponent != nullptr);
+	FGraphAggregateChannel& ChannelData = AggregateChannels.FindChecked(Channel);
+
+	const uint32 Stamp = ++ChannelData.NextStamp;
+	ChannelData.ValueStamps.Add(Vertex, Stamp);
+	ConnectedComponent->ValueHeaps.FindOrAdd(Channel).Push(Value, Stamp, Vertex);
+}
+
+void UGraphConnectedComponentsMonitor::Aggregate_UpdateHeaps(UGraphConnectedComponent* ConnectedComponent, FName Channel,
+                                                             const bool bRecoverExtrema)
+{
+	check(ConnectedComponent != nullptr);
+	const FGraphAggregateChannel& ChannelData = AggregateChannels.FindChecked(Channel);
+	const FGraphComponentAggregate& Aggregate = ConnectedComponent->Aggregates.FindChecked(Channel);
+	FGraphComponentValueHeaps& Heaps = ConnectedComponent->ValueHeaps.FindChecked(Channel);
+
+	if (Aggregate.Count == 0)
+	{
+		Heaps.Reset();
+		return;
+	}
+
+	auto IsCurrent = [&ChannelData](const FGraphComponentValueHeaps::FEntry& Entry)
+	{
+		const uint32* Stamp = ChannelData.ValueStamps.Find(Entry.Vertex);
+		return Stamp != nullptr && *Stamp == Entry.Stamp;
+	};
+	if (bRecoverExtrema)
+	{
+		Heaps.RecoverExtrema(IsCurrent, ConnectedComponent->Aggregates.FindChecked(Channel));
+	}
+	Heaps.CompactIfStale(IsCurrent, Aggregate.Count);
+}
+
+void UGraphConnectedComponentsMonitor::Aggregate_RemoveValue(UGraphConnectedComponent* ConnectedComponent, FName Channel, float Value)
+{
+	check(ConnectedComponent != nullptr);
+
+	// The value and its stamp must already be gone from the channel, so its heap entries are stale
+	const bool bExtremaKept = ConnectedComponent->Aggregates.FindChecked(Channel).Remove(Value);
+	Aggregate_UpdateHeaps(ConnectedComponent, Channel, !bExtremaKept);
+}
+
 void UGraphConnectedComponentsMonitor::GraphStructure_VertexAdded(UGraphStructureVertex* Vertex)
 {
 	check(Vertex != nullptr);
@@ -51,7 +356,7 @@ void UGraphConnectedComponentsMonitor::GraphStructure_VertexAdded(UGraphStructur
 	check(!VerticesComponentsMap.Contains(Vertex));
 
 	// Since freshly spawned vertices never have any connection yet just spawn a new ConnectionComponent, but check to be sure
-	check(Vertex->Edges.IsEmpty());
+	check(Vertex->Adjacency.IsEmpty());
 
 	UGraphConnectedComponent* NewConnectedComponent = ConnectedComponent_Spawn();
 	ConnectedComponent_AddVertex(NewConnectedComponent, Vertex);
@@ -64,11 +369,21 @@ void UGraphConnectedComponentsMonitor::GraphStructure_VertexRemoved(UGraphStruct
 {
 	check(Vertex != nullptr);
 	// Since the RemoveVertex functions in the graph always remove Edges first we don't have to deal with them, but check to be sure
-	check(Vertex->Edges.IsEmpty());
+	check(Vertex->Adjacency.IsEmpty());
 
 	UGraphConnectedComponent* ConnectedComponent = VerticesComponentsMap.FindAndRemoveChecked(Vertex);
 	ConnectedComponent_RemoveVertex(ConnectedComponent, Vertex);
 
+	for (auto& ChannelPair : AggregateChannels)
+	{
+		float Value;
+		if (ChannelPair.Value.VertexValues.RemoveAndCopyValue(Vertex, Value))
+		{
+			ChannelPair.Value.ValueStamps.Remove(Vertex);
+			Aggregate_RemoveValue(ConnectedComponent, ChannelPair.Key, Value);
+		}
+	}
+
 	if (ConnectedComponent->Vertices.IsEmpty())
 	{
 		ConnectedComponent_Destroy(ConnectedComponent);
@@ -111,13 +426,8 @@ void UGraphConnectedComponentsMonitor::GraphStructure_EdgeAdded(UGraphStructureE
 	}
 
 	// Copy Vertices set and move each vertex to the bigger component
-	TSet<UGraphStructureVertex*> MigrateVertices = MergeConnectedComponent->Vertices;
-	for (UGraphStructureVertex* MigrateVertex : MigrateVertices)
-	{
-		ConnectedComponent_RemoveVertex(MergeConnectedComponent, MigrateVertex);
-		ConnectedComponent_AddVertex(KeepConnectedComponent, MigrateVertex);
-		VerticesComponentsMap.Add(MigrateVertex, KeepConnectedComponent);
-	}
+	const TSet<UGraphStructureVertex*> MigrateVertices = MergeConnectedComponent->Vertices;
+	ConnectedComponent_MoveVertices(MergeConnectedComponent, KeepConnectedComponent, MigrateVertices);
 
 	ConnectedComponent_Destroy(MergeConnectedComponent);
 }
@@ -126,6 +436,12 @@ void UGraphConnectedComponentsMonitor::GraphStructure_EdgeRemoved(UGraphStructur
 {
 	check(Edge != nullptr);
 
+	// Edges of a removed vertex were already handled together in GraphStructure_VertexEdgesRemoved
+	if (Graph->IsRemovedWithVertex(Edge))
+	{
+		return;
+	}
+
 	UGraphStructureVertex* Source = Edge->Source;
 	check(Source != nullptr);
 	UGraphStructureVertex* Target = Edge->Target;
@@ -138,31 +454,151 @@ void UGraphConnectedComponentsMonitor::GraphStructure_EdgeRemoved(UGraphStructur
 	check(AffectedConnectedComponent->Vertices.Contains(Source));
 	check(AffectedConnectedComponent->Vertices.Contains(Target));
 
-	const TSet<UGraphStructureVertex*> FoundVertices = Graph->FindAllConnectedVertices(Source);
-	if (FoundVertices.Contains(Target))
+	// Self-loops never disconnect anything
+	if (Source == Target)
 	{
-		// Target vertex found, the vertices are still connected someway else, no need to split component
 		return;
 	}
 
-	// Component needs to be split
+	// Searching from both sides at once finishes after exploring the smaller side if the component has to be split
+	ConnectedComponent_HandleEdgesRemoved(AffectedConnectedComponent, {Source, Target});
+}
 
-	// Determine which side of edge is easier to split off into new component, split off smaller side
-	const int32 OriginalCount = AffectedConnectedComponent->Vertices.Num();
-	const int32 FoundCount = FoundVertices.Num();
+void UGraphConnectedComponentsMonitor::GraphStructure_VertexEdgesRemoved(UGraphStructureVertex* Vertex, const TArray<UGraphStructureEdge*>& Edges)
+{
+	check(Vertex != nullptr);
+	check(Vertex->Adjacency.IsEmpty());
 
-	const TSet<UGraphStructureVertex*> OtherVertices = AffectedConnectedComponent->Vertices.Difference(FoundVertices);
-	check(!OtherVertices.Contains(Source));
+	UGraphConnectedComponent* AffectedConnectedComponent = VerticesComponentsMap.FindChecked(Vertex);
 
-	TSet<UGraphStructureVertex*> SplitOffVertices = FoundCount > OriginalCount / 2 ? OtherVertices : FoundVertices;
+	// The former neighbours are the only vertices that can end up in different parts of the component
+	TArray<UGraphStructureVertex*> FormerNeighbours;
+	FormerNeighbours.Reserve(Edges.Num());
+	for (const UGraphStructureEdge* Edge : Edges)
+	{
+		check(Edge != nullptr);
+		UGraphStructureVertex* Neighbour = Edge->Source == Vertex ? Edge->Target : Edge->Source;
+		check(VerticesComponentsMap.FindChecked(Neighbour) == AffectedConnectedComponent);
 
-	UGraphConnectedComponent* NewConnectedComponent = ConnectedComponent_Spawn();
+		if (Neighbour != Vertex)
+		{
+			FormerNeighbours.Add(Neighbour);
+		}
+	}
+
+	// The removed vertex itself is isolated now and stays in the existing component until it is removed
+	ConnectedComponent_HandleEdgesRemoved(AffectedConnectedComponent, FormerNeighbours);
+}
+
+void UGraphConnectedComponentsMonitor::GraphStructure_BulkAdded(const TArray<UGraphStructureVertex*>& NewVertices,
+                                                                const TArray<UGraphStructureEdge*>& NewEdges)
+{
+	// Union-find over the new vertices and the existing components touched by new edges, so every resulting component is
+	// assembled once instead of spawning a component per vertex and merging them edge by edge.
+	// Nodes [0, NewVertices.Num()) are the new vertices, which have consecutive GraphIds, the remaining nodes are existing components.
+
+	const int32 NumNewVertices = NewVertices.Num();
+	const int32 FirstNewVertexId = NumNewVertices > 0 ? NewVertices[0]->GraphId : INDEX_NONE;
+
+	TArray<int32> Parents;
+	TArray<int32> Sizes;
+	Parents.Reserve(NumNewVertices);
+	Sizes.Init(1, NumNewVertices);
+	for (int32 Node = 0; Node < NumNewVertices; ++Node)
+	{
+		check(NewVertices[Node]->GraphId == FirstNewVertexId + Node);
+		check(!VerticesComponentsMap.Contains(NewVertices[Node]));
+		Parents.Add(Node);
+	}
+
+	TMap<UGraphConnectedComponent*, int32> ComponentNodes;
+	TArray<UGraphConnectedComponent*> NodeComponents;
+
+	auto GetNode = [&](UGraphStructureVertex* Vertex) -> int32
+	{
+		const int32 NewVertexIndex = Vertex->GraphId - FirstNewVertexId;
+		if (NewVertices.IsValidIndex(NewVertexIndex) && NewVertices[NewVertexIndex] == Vertex)
+		{
+			return NewVertexIndex;
+		}
+
+		UGraphConnectedComponent* ConnectedComponent = VerticesComponentsMap.FindChecked(Vertex);
+		if (const int32* ExistingNode = ComponentNodes.Find(ConnectedComponent))
+		{
+			return *ExistingNode;
+		}
+
+		const int32 Node = Parents.Add(Parents.Num());
+		Sizes.Add(1);
+		NodeComponents.Add(ConnectedComponent);
+		ComponentNodes.Add(ConnectedComponent, Node);
+		return Node;
+	};
+
+	auto FindRoot = [&](int32 Node) -> int32
+	{
+		while (Parents[Node] != Node)
+		{
+			Parents[Node] = Parents[Parents[Node]];
+			Node = Parents[Node];
+		}
+		return Node;
+	};
+
+	for (const UGraphStructureEdge* Edge : NewEdges)
+	{
+		check(Edge != nullptr);
+		int32 SourceRoot = FindRoot(GetNode(Edge->Source));
+		int32 TargetRoot = FindRoot(GetNode(Edge->Target));
+		if (SourceRoot == TargetRoot)
+		{
+			continue;
+		}
+
+		if (Sizes[SourceRoot] < Sizes[TargetRoot])
+		{
+			Swap(SourceRoot, TargetRoot);
+		}
+		Parents[TargetRoot] = SourceRoot;
+		Sizes[SourceRoot] += Sizes[TargetRoot];
+	}
+
+	// Keep the biggest existing component of every group, merge the other existing components of the group into it
+	TArray<UGraphConnectedComponent*> RootComponents;
+	RootComponents.SetNumZeroed(Parents.Num());
+	for (int32 ComponentIndex = 0; ComponentIndex < NodeComponents.Num(); ++ComponentIndex)
+	{
+		UGraphConnectedComponent* ConnectedComponent = NodeComponents[ComponentIndex];
+		UGraphConnectedComponent*& RootComponent = RootComponents[FindRoot(NumNewVertices + ComponentIndex)];
+		if (RootComponent == nullptr || ConnectedComponent->Vertices.Num() > RootComponent->Vertices.Num())
+		{
+			RootComponent = ConnectedComponent;
+		}
+	}
 
-	for (UGraphStructureVertex* SplitOffVertex : SplitOffVertices)
+	for (int32 ComponentIndex = 0; ComponentIndex < NodeComponents.Num(); ++ComponentIndex)
 	{
-		ConnectedComponent_RemoveVertex(AffectedConnectedComponent, SplitOffVertex);
-		ConnectedComponent_AddVertex(NewConnectedComponent, SplitOffVertex);
-		VerticesComponentsMap.Add(SplitOffVertex, NewConnectedComponent);
+		UGraphConnectedComponent* MergeConnectedComponent = NodeComponents[ComponentIndex];
+		UGraphConnectedComponent* KeepConnectedComponent = RootComponents[FindRoot(NumNewVertices + ComponentIndex)];
+		if (MergeConnectedComponent != KeepConnectedComponent)
+		{
+			const TSet<UGraphStructureVertex*> MigrateVertices = MergeConnectedComponent->Vertices;
+			ConnectedComponent_MoveVertices(MergeConnectedComponent, KeepConnectedComponent, MigrateVertices);
+			ConnectedComponent_Destroy(MergeConnectedComponent);
+		}
+	}
+
+	// Add new vertices, groups consisting only of new vertices get a freshly spawned component
+	for (int32 Node = 0; Node < NumNewVertices; ++Node)
+	{
+		UGraphConnectedComponent*& RootComponent = RootComponents[FindRoot(Node)];
+		if (RootComponent == nullptr)
+		{
+			RootComponent = ConnectedComponent_Spawn();
+		}
+
+		ConnectedComponent_AddVertex(RootComponent, NewVertices[Node]);
+		VerticesComponentsMap.Add(NewVertices[Node], RootComponent);
 	}
 }
 
@@ -187,6 +623,8 @@ void UGraphConnectedComponentsMonitor::Setup(UGraphStructure* MonitorGraph, TSub
 	Graph->OnVertexRemoved.AddDynamic(this, &UGraphConnectedComponentsMonitor::GraphStructure_VertexRemoved);
 	Graph->OnEdgeAdded.AddDynamic(this, &UGraphConnectedComponentsMonitor::GraphStructure_EdgeAdded);
 	Graph->OnEdgeRemoved.AddDynamic(this, &UGraphConnectedComponentsMonitor::GraphStructure_EdgeRemoved);
+	Graph->OnVertexEdgesRemoved.AddDynamic(this, &UGraphConnectedComponentsMonitor::GraphStructure_VertexEdgesRemoved);
+	Graph->OnBulkAdded.AddDynamic(this, &UGraphConnectedComponentsMonitor::GraphStructure_BulkAdded);
 
 	// Setup initial connected components
 
@@ -219,8 +657,44 @@ void UGraphConnectedComponentsMonitor::Setup(UGraphStructure* MonitorGraph, TSub
 	SetupCompleted = true;
 }
 
+void UGraphConnectedComponentsMonitor::HandleEndOfFrame()
+{
+	if (bResolveAtEndOfFrame)
+	{
+		ResolvePendingSplits();
+	}
+	if (bCoalesceEvents)
+	{
+		FlushComponentEvents();
+	}
+}
+
+void UGraphConnectedComponentsMonitor::UpdateEndOfFrameBinding()
+{
+	const bool bNeedsEndOfFrame = bResolveAtEndOfFrame || bCoalesceEvents;
+	if (bNeedsEndOfFrame && !EndOfFrameHandle.IsValid())
+	{
+		EndOfFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UGraphConnectedComponentsMonitor::HandleEndOfFrame);
+	}
+	else if (!bNeedsEndOfFrame && EndOfFrameHandle.IsValid())
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndOfFrameHandle);
+		EndOfFrameHandle.Reset();
+	}
+}
+
+void UGraphConnectedComponentsMonitor::BeginDestroy()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndOfFrameHandle);
+	EndOfFrameHandle.Reset();
+
+	Super::BeginDestroy();
+}
+
 TSet<UGraphConnectedComponent*> UGraphConnectedComponentsMonitor::GetAllUsedConnectedComponents()
 {
+	ResolvePendingSplits();
+
 	TSet<UGraphConnectedComponent*> AllUsedConnectedComponents;
 	for (auto Pair : VerticesComponentsMap)
 	{
@@ -228,3 +702,287 @@ TSet<UGraphConnectedComponent*> UGraphConnectedComponentsMonitor::GetAllUsedConn
 	}
 	return AllUsedConnectedComponents;
 }
+
+void UGraphConnectedComponentsMonitor::AddAggregateChannel(FName Channel)
+{
+	// Components create their aggregate of a channel lazily once the first value is set
+	AggregateChannels.FindOrAdd(Channel);
+}
+
+bool UGraphConnectedComponentsMonitor::SetVertexValue(FName Channel, UGraphStructureVertex* Vertex, float Value)
+{
+	FGraphAggregateChannel* ChannelData = AggregateChannels.Find(Channel);
+	if (!ensureMsgf(ChannelData != nullptr, TEXT("Aggregate channel %s has not been added"), *Channel.ToString()))
+	{
+		return false;
+	}
+
+	UGraphConnectedComponent** ConnectedComponent = VerticesComponentsMap.Find(Vertex);
+	if (ConnectedComponent == nullptr)
+	{
+		return false;
+	}
+
+	FGraphComponentAggregate& Aggregate = (*ConnectedComponent)->Aggregates.FindOrAdd(Channel);
+	Aggregate_PushValue(*ConnectedComponent, Channel, Vertex, Value);
+	if (float* StoredValue = ChannelData->VertexValues.Find(Vertex))
+	{
+		const float OldValue = *StoredValue;
+		*StoredValue = Value;
+
+		// Add the new value before removing the old one, so an extreme value that stays extreme doesn't touch the heaps
+		Aggregate.Add(Value);
+		const bool bExtremaKept = Aggregate.Remove(OldValue);
+		Aggregate_UpdateHeaps(*ConnectedComponent, Channel, !bExtremaKept);
+	}
+	else
+	{
+		ChannelData->VertexValues.Add(Vertex, Value);
+		Aggregate.Add(Value);
+	}
+	return true;
+}
+
+bool UGraphConnectedComponentsMonitor::ClearVertexValue(FName Channel, UGraphStructureVertex* Vertex)
+{
+	FGraphAggregateChannel* ChannelData = AggregateChannels.Find(Channel);
+	float Value;
+	if (ChannelData == nullptr || !ChannelData->VertexValues.RemoveAndCopyValue(Vertex, Value))
+	{
+		return false;
+	}
+	ChannelData->ValueStamps.Remove(Vertex);
+
+	Aggregate_RemoveValue(VerticesComponentsMap.FindChecked(Vertex), Channel, Value);
+	return true;
+}
+
+bool UGraphConnectedComponentsMonitor::GetVertexValue(FName Channel, UGraphStructureVertex* Vertex, float& Value)
+{
+	const FGraphAggregateChannel* ChannelData = AggregateChannels.Find(Channel);
+	const float* StoredValue = ChannelData != nullptr ? ChannelData->VertexValues.Find(Vertex) : nullptr;
+	if (StoredValue == nullptr)
+	{
+		return false;
+	}
+
+	Value = *StoredValue;
+	return true;
+}
+
+UGraphConnectedComponent* UGraphConnectedComponentsMonitor::GetConnectedComponentOfVertex(UGraphStructureVertex* Vertex)
+{
+	ResolvePendingSplits();
+
+	return VerticesComponentsMap.FindRef(Vertex);
+}
+
+void UGraphConnectedComponentsMonitor::SetLazyMode(bool bEnabled, bool bResolveAtEndOfFrameIfEnabled)
+{
+	if (!bEnabled)
+	{
+		ResolvePendingSplits();
+	}
+
+	bLazyMode = bEnabled;
+	bResolveAtEndOfFrame = bEnabled && bResolveAtEndOfFrameIfEnabled;
+
+	UpdateEndOfFrameBinding();
+}
+
+bool UGraphConnectedComponentsMonitor::IsLazyMode() const
+{
+	return bLazyMode;
+}
+
+bool UGraphConnectedComponentsMonitor::HasPendingSplits() const
+{
+	return !PendingSplits.IsEmpty();
+}
+
+void UGraphConnectedComponentsMonitor::ResolvePendingSplits()
+{
+	if (PendingSplits.IsEmpty())
+	{
+		return;
+	}
+
+	// Take the pending splits first, queries from within component events then see an already clean monitor instead of recursing
+	TMap<UGraphConnectedComponent*, FGraphPendingSplit> ResolveSplits = MoveTemp(PendingSplits);
+	PendingSplits.Reset();
+
+	for (auto& Pair : ResolveSplits)
+	{
+		UGraphConnectedComponent* ConnectedComponent = Pair.Key;
+
+		// Start vertices may have been removed from the graph since, only search from the ones still in this component
+		TArray<UGraphStructureVertex*> StartVertices;
+		StartVertices.Reserve(Pair.Value.StartVertices.Num());
+		for (UGraphStructureVertex* StartVertex : Pair.Value.StartVertices)
+		{
+			if (VerticesComponentsMap.FindRef(StartVertex) == ConnectedComponent)
+			{
+				StartVertices.Add(StartVertex);
+			}
+		}
+
+		ConnectedComponent_SplitDisconnected(ConnectedComponent, StartVertices);
+	}
+}
+
+SIZE_T UGraphConnectedComponentsMonitor::GetOwnAllocatedSize() const
+{
+	SIZE_T Size = VerticesComponentsMap.GetAllocatedSize() + AggregateChannels.GetAllocatedSize() + PendingSplits.GetAllocatedSize();
+	for (const auto& Pair : AggregateChannels)
+	{
+		Size += Pair.Value.VertexValues.GetAllocatedSize() + Pair.Value.ValueStamps.GetAllocatedSize();
+	}
+	for (const auto& Pair : PendingSplits)
+	{
+		Size += Pair.Value.StartVertices.GetAllocatedSize();
+	}
+	Size += PendingChanges.GetAllocatedSize();
+	for (const auto& Pair : PendingChanges)
+	{
+		Size += Pair.Value.AddedVertices.GetAllocatedSize() + Pair.Value.RemovedVertices.GetAllocatedSize();
+		Size += Pair.Value.MergedFrom.GetAllocatedSize() + Pair.Value.SplitInto.GetAllocatedSize();
+	}
+	return Size;
+}
+
+SIZE_T UGraphConnectedComponentsMonitor::GetAllocatedSize() const
+{
+	SIZE_T Size = GetOwnAllocatedSize();
+
+	// Collected without resolving pending splits, taking a measurement should not fire component events
+	TSet<const UGraphConnectedComponent*> ConnectedComponents;
+	for (const auto& Pair : VerticesComponentsMap)
+	{
+		ConnectedComponents.Add(Pair.Value);
+	}
+	for (const UGraphConnectedComponent* ConnectedComponent : ConnectedComponents)
+	{
+		Size += ConnectedComponent->GetClass()->GetStructureSize() + ConnectedComponent->GetAllocatedSize();
+	}
+	return Size;
+}
+
+void UGraphConnectedComponentsMonitor::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// Components report their own resource size
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetOwnAllocatedSize());
+}
+
+void UGraphConnectedComponentsMonitor::Shrink()
+{
+	VerticesComponentsMap.Compact();
+	VerticesComponentsMap.Shrink();
+	for (auto& Pair : AggregateChannels)
+	{
+		Pair.Value.VertexValues.Compact();
+		Pair.Value.VertexValues.Shrink();
+		Pair.Value.ValueStamps.Compact();
+		Pair.Value.ValueStamps.Shrink();
+	}
+
+	TSet<UGraphConnectedComponent*> ConnectedComponents;
+	for (const auto& Pair : VerticesComponentsMap)
+	{
+		ConnectedComponents.Add(Pair.Value);
+	}
+	for (UGraphConnectedComponent* ConnectedComponent : ConnectedComponents)
+	{
+		ConnectedComponent->Shrink();
+	}
+}
+
+void UGraphConnectedComponentsMonitor::SetCoalesceEvents(bool bEnabled)
+{
+	if (!bEnabled)
+	{
+		FlushComponentEvents();
+	}
+
+	bCoalesceEvents = bEnabled;
+
+	UpdateEndOfFrameBinding();
+}
+
+bool UGraphConnectedComponentsMonitor::IsCoalescingEvents() const
+{
+	return bCoalesceEvents;
+}
+
+void UGraphConnectedComponentsMonitor::FlushComponentEvents()
+{
+	// Diffs have to describe the actual components, so splits held back in lazy mode are resolved first regardless of
+	// bResolveAtEndOfFrame. Resolving records its changes as well and they are delivered together with the others
+	ResolvePendingSplits();
+
+	if (PendingChanges.IsEmpty())
+	{
+		return;
+	}
+
+	// Take the recorded changes first, changes made by the events themselves are recorded again and delivered with the next flush
+	TMap<UGraphConnectedComponent*, FGraphComponentChangeRecord> Changes = MoveTemp(PendingChanges);
+	PendingChanges.Reset();
+
+	auto IsTransient = [&Changes](UGraphConnectedComponent* ConnectedComponent)
+	{
+		const FGraphComponentChangeRecord* ChangeRecord = Changes.Find(ConnectedComponent);
+		return ChangeRecord != nullptr && ChangeRecord->bCreated && ChangeRecord->bDestroyed;
+	};
+
+	// Deliver all creations before any diffs, so partners listed in a diff have already been announced
+
+	for (const auto& Pair : Changes)
+	{
+		if (Pair.Value.bCreated && !Pair.Value.bDestroyed)
+		{
+			Pair.Key->OnCreated();
+		}
+	}
+
+	for (const auto& Pair : Changes)
+	{
+		const FGraphComponentChangeRecord& ChangeRecord = Pair.Value;
+		if (ChangeRecord.bCreated && ChangeRecord.bDestroyed)
+		{
+			continue;
+		}
+
+		FGraphConnectedComponentDiff Diff;
+		Diff.AddedVertices = ChangeRecord.AddedVertices.Array();
+		Diff.RemovedVertices = ChangeRecord.RemovedVertices.Array();
+		for (UGraphConnectedComponent* MergedFrom : ChangeRecord.MergedFrom)
+		{
+			if (!IsTransient(MergedFrom))
+			{
+				Diff.MergedFrom.Add(MergedFrom);
+			}
+		}
+		for (UGraphConnectedComponent* SplitInto : ChangeRecord.SplitInto)
+		{
+			if (!IsTransient(SplitInto))
+			{
+				Diff.SplitInto.Add(SplitInto);
+			}
+		}
+
+		if (!Diff.AddedVertices.IsEmpty() || !Diff.RemovedVertices.IsEmpty() || !Diff.MergedFrom.IsEmpty() || !Diff.SplitInto.IsEmpty())
+		{
+			Pair.Key->OnChanged(Diff);
+		}
+	}
+
+	for (const auto& Pair : Changes)
+	{
+		if (Pair.Value.bDestroyed && !Pair.Value.bCreated)
+		{
+			Pair.Key->OnDestroyed();
+		}
+	}
+}
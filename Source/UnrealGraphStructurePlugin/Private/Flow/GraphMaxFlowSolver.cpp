@@ -0,0 +1,394 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Flow/GraphMaxFlowSolver.h"
+
+namespace
+{
+	// Residuals below this are considered saturated to avoid chasing floating point noise
+	constexpr double FlowEpsilon = 1e-6;
+
+	// Residual network in compressed sparse row layout, every undirected edge is represented by two opposing arcs which both
+	// start out with the full capacity of the edge
+	struct FResidualNetwork
+	{
+		// Arcs leaving vertex V are [FirstArc[V], FirstArc[V + 1])
+		TArray<int32> FirstArc;
+		TArray<int32> ArcTarget;
+		TArray<int32> ArcReverse;
+		TArray<double> ArcResidual;
+
+		int32 NumVertices() const
+		{
+			return FirstArc.Num() - 1;
+		}
+
+		int32 ArcTail(const int32 Arc) const
+		{
+			return ArcTarget[ArcReverse[Arc]];
+		}
+
+		// Net flow along the arc in its own direction
+		double Flow(const int32 Arc) const
+		{
+			return (ArcResidual[ArcReverse[Arc]] - ArcResidual[Arc]) * 0.5;
+		}
+
+		void Push(const int32 Arc, const double Amount)
+		{
+			ArcResidual[Arc] -= Amount;
+			ArcResidual[ArcReverse[Arc]] += Amount;
+		}
+	};
+
+	// Remove flow until every vertex except source and sink is balanced again, needed after a warm-start since capacities may
+	// have been lowered or edges removed. Excess is pushed back along incoming flow and deficits along outgoing flow, every push
+	// lowers the total flow on the edges so this always terminates.
+	void RestoreFlowConservation(FResidualNetwork& Network, const int32 Source, const int32 Sink)
+	{
+		const int32 NumVertices = Network.NumVertices();
+
+		// Inflow minus outflow of every vertex
+		TArray<double> Imbalance;
+		Imbalance.SetNumZeroed(NumVertices);
+		for (int32 V = 0; V < NumVertices; ++V)
+		{
+			for (int32 Arc = Network.FirstArc[V]; Arc < Network.FirstArc[V + 1]; ++Arc)
+			{
+				Imbalance[V] -= Network.Flow(Arc);
+			}
+		}
+
+		TArray<bool> Queued;
+		Queued.SetNumZeroed(NumVertices);
+		TArray<int32> WorkList;
+		auto Enqueue = [&](const int32 V)
+		{
+			if (V != Source && V != Sink && !Queued[V] && FMath::Abs(Imbalance[V]) > FlowEpsilon)
+			{
+				Queued[V] = true;
+				WorkList.Push(V);
+			}
+		};
+
+		for (int32 V = 0; V < NumVertices; ++V)
+		{
+			Enqueue(V);
+		}
+
+		while (!WorkList.IsEmpty())
+		{
+			const int32 V = WorkList.Pop(EAllowShrinking::No);
+			Queued[V] = false;
+
+			for (int32 Arc = Network.FirstArc[V]; Arc < Network.FirstArc[V + 1] && FMath::Abs(Imbalance[V]) > FlowEpsilon; ++Arc)
+			{
+				const double ArcFlow = Network.Flow(Arc);
+				const int32 W = Network.ArcTarget[Arc];
+
+				double Amount = 0.0;
+				if (Imbalance[V] > 0.0 && ArcFlow < -FlowEpsilon)
+				{
+					// Excess, send it back to where it came from
+					Amount = FMath::Min(Imbalance[V], -ArcFlow);
+				}
+				else if (Imbalance[V] < 0.0 && ArcFlow > FlowEpsilon)
+				{
+					// Deficit, stop sending flow further than we receive
+					Amount = -FMath::Min(-Imbalance[V], ArcFlow);
+				}
+				else
+				{
+					continue;
+				}
+
+				Network.Push(Arc, Amount);
+				Imbalance[V] -= Amount;
+				Imbalance[W] += Amount;
+				Enqueue(W);
+			}
+
+			// Whatever is left at this point is rounding error
+			Imbalance[V] = 0.0;
+		}
+	}
+
+	bool BuildLevelGraph(const FResidualNetwork& Network, const int32 Source, const int32 Sink, TArray<int32>& Levels)
+	{
+		Levels.Init(INDEX_NONE, Network.NumVertices());
+
+		TArray<int32> Queue;
+		Queue.Reserve(Network.NumVertices());
+		Levels[Source] = 0;
+		Queue.Add(Source);
+
+		for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+		{
+			const int32 V = Queue[QueueIndex];
+			for (int32 Arc = Network.FirstArc[V]; Arc < Network.FirstArc[V + 1]; ++Arc)
+			{
+				const int32 W = Network.ArcTarget[Arc];
+				if (Levels[W] == INDEX_NONE && Network.ArcResidual[Arc] > FlowEpsilon)
+				{
+					Levels[W] = Levels[V] + 1;
+					Queue.Add(W);
+				}
+			}
+		}
+
+		return Levels[Sink] != INDEX_NONE;
+	}
+
+	// Saturate all shortest augmenting paths of the current level graph, iterative to stay safe on long paths
+	double AugmentBlockingFlow(FResidualNetwork& Network, const int32 Source, const int32 Sink, TArray<int32>& Levels)
+	{
+		TArray<int32> CurrentArc(Network.FirstArc.GetData(), Network.NumVertices());
+		TArray<int32> PathArcs;
+
+		double TotalAugmented = 0.0;
+		int32 V = Source;
+		while (true)
+		{
+			if (V == Sink)
+			{
+				double Bottleneck = TNumericLimits<double>::Max();
+				for (const int32 Arc : PathArcs)
+				{
+					Bottleneck = FMath::Min(Bottleneck, Network.ArcResidual[Arc]);
+				}
+
+				int32 FirstSaturated = INDEX_NONE;
+				for (int32 PathIndex = 0; PathIndex < PathArcs.Num(); ++PathIndex)
+				{
+					Network.Push(PathArcs[PathIndex], Bottleneck);
+					if (FirstSaturated == INDEX_NONE && Network.ArcResidual[PathArcs[PathIndex]] <= FlowEpsilon)
+					{
+						FirstSaturated = PathIndex;
+					}
+				}
+				TotalAugmented += Bottleneck;
+
+				// Continue from the tail of the first saturated arc, everything before it may still carry more flow
+				check(FirstSaturated != INDEX_NONE);
+				V = Network.ArcTail(PathArcs[FirstSaturated]);
+				PathArcs.SetNum(FirstSaturated, EAllowShrinking::No);
+				continue;
+			}
+
+			bool Advanced = false;
+			for (; CurrentArc[V] < Network.FirstArc[V + 1]; ++CurrentArc[V])
+			{
+				const int32 Arc = CurrentArc[V];
+				const int32 W = Network.ArcTarget[Arc];
+				if (Network.ArcResidual[Arc] > FlowEpsilon && Levels[W] == Levels[V] + 1)
+				{
+					PathArcs.Add(Arc);
+					V = W;
+					Advanced = true;
+					break;
+				}
+			}
+
+			if (!Advanced)
+			{
+				if (V == Source)
+				{
+					break;
+				}
+
+				// Dead end, drop vertex from the level graph and retreat
+				Levels[V] = INDEX_NONE;
+				V = Network.ArcTail(PathArcs.Pop(EAllowShrinking::No));
+				++CurrentArc[V];
+			}
+		}
+
+		return TotalAugmented;
+	}
+}
+
+float UGraphMaxFlowSolver::ComputeMaxFlow(UGraphStructure* Graph, UGraphStructureVertex* SourceVertex, UGraphStructureVertex* SinkVertex,
+                                          FName CapacityAttribute)
+{
+	if (!ensure(Graph != nullptr) || !ensure(SourceVertex != nullptr) || !ensure(SinkVertex != nullptr))
+	{
+		Reset();
+		return 0.0f;
+	}
+
+	const bool bWarmStart = Graph == LastGraph && SourceVertex == LastSource && SinkVertex == LastSink;
+	TMap<UGraphStructureEdge*, float> PreviousEdgeFlows;
+	if (bWarmStart)
+	{
+		PreviousEdgeFlows = MoveTemp(EdgeFlows);
+	}
+	Reset();
+
+	if (!ensure(Graph->ContainsVertex(SourceVertex)) || !ensure(Graph->ContainsVertex(SinkVertex)))
+	{
+		return 0.0f;
+	}
+	const int32 Source = SourceVertex->GraphId;
+	const int32 Sink = SinkVertex->GraphId;
+	const int32 NumVertices = Graph->GetNumVertices();
+
+	TConstArrayView<float> CapacityColumn;
+	if (!CapacityAttribute.IsNone())
+	{
+		const FGraphAttributeTable& EdgeAttributes = Graph->GetEdgeAttributes();
+		if (!ensureMsgf(EdgeAttributes.HasColumn(CapacityAttribute, EGraphAttributeType::Float), TEXT("No edge float attribute %s"),
+		                *CapacityAttribute.ToString()))
+		{
+			return 0.0f;
+		}
+		CapacityColumn = EdgeAttributes.GetColumn<float>(CapacityAttribute);
+	}
+
+	// Build residual network indexed by vertex ids, self-loops can never carry flow and are left out
+
+	const TConstArrayView<UGraphStructureEdge*> Edges = Graph->GetEdgeArray();
+	TArray<UGraphStructureEdge*> NetworkEdges;
+	TArray<FIntPoint> NetworkEdgeEndpoints;
+	NetworkEdges.Reserve(Edges.Num());
+	NetworkEdgeEndpoints.Reserve(Edges.Num());
+	EdgeFlows.Reserve(Edges.Num());
+
+	FResidualNetwork Network;
+	Network.FirstArc.SetNumZeroed(NumVertices + 1);
+
+	for (UGraphStructureEdge* Edge : Edges)
+	{
+		check(Edge != nullptr);
+		EdgeFlows.Add(Edge, 0.0f);
+
+		const int32 U = Edge->Source->GraphId;
+		const int32 W = Edge->Target->GraphId;
+		if (U == W)
+		{
+			continue;
+		}
+
+		NetworkEdges.Add(Edge);
+		NetworkEdgeEndpoints.Emplace(U, W);
+		++Network.FirstArc[U + 1];
+		++Network.FirstArc[W + 1];
+	}
+
+	for (int32 V = 0; V < NumVertices; ++V)
+	{
+		Network.FirstArc[V + 1] += Network.FirstArc[V];
+	}
+
+	const int32 NumArcs = Network.FirstArc.Last();
+	Network.ArcTarget.SetNumUninitialized(NumArcs);
+	Network.ArcReverse.SetNumUninitialized(NumArcs);
+	Network.ArcResidual.SetNumUninitialized(NumArcs);
+
+	TArray<int32> NextArc(Network.FirstArc.GetData(), NumVertices);
+	TArray<int32> EdgeArcs;
+	EdgeArcs.SetNumUninitialized(NetworkEdges.Num());
+
+	for (int32 EdgeIndex = 0; EdgeIndex < NetworkEdges.Num(); ++EdgeIndex)
+	{
+		const UGraphStructureEdge* Edge = NetworkEdges[EdgeIndex];
+		const int32 U = NetworkEdgeEndpoints[EdgeIndex].X;
+		const int32 W = NetworkEdgeEndpoints[EdgeIndex].Y;
+
+		const float EdgeCapacity = CapacityColumn.Num() > 0 ? CapacityColumn[Edge->GraphId] : Edge->Capacity;
+		const double Capacity = FMath::Max(EdgeCapacity, 0.0f);
+		double InitialFlow = 0.0;
+		if (const float* PreviousFlow = PreviousEdgeFlows.Find(Edge))
+		{
+			InitialFlow = FMath::Clamp(static_cast<double>(*PreviousFlow), -Capacity, Capacity);
+		}
+
+		const int32 ForwardArc = NextArc[U]++;
+		const int32 BackwardArc = NextArc[W]++;
+		Network.ArcTarget[ForwardArc] = W;
+		Network.ArcTarget[BackwardArc] = U;
+		Network.ArcReverse[ForwardArc] = BackwardArc;
+		Network.ArcReverse[BackwardArc] = ForwardArc;
+		Network.ArcResidual[ForwardArc] = Capacity - InitialFlow;
+		Network.ArcResidual[BackwardArc] = Capacity + InitialFlow;
+
+		EdgeArcs[EdgeIndex] = ForwardArc;
+	}
+
+	LastGraph = Graph;
+	LastSource = SourceVertex;
+	LastSink = SinkVertex;
+
+	if (Source == Sink)
+	{
+		return 0.0f;
+	}
+
+	if (bWarmStart)
+	{
+		RestoreFlowConservation(Network, Source, Sink);
+	}
+
+	// Dinic's algorithm: augment along blocking flows of shortest residual paths until the sink becomes unreachable
+
+	TArray<int32> Levels;
+	while (BuildLevelGraph(Network, Source, Sink, Levels))
+	{
+		AugmentBlockingFlow(Network, Source, Sink, Levels);
+	}
+
+	// Collect results, the final level graph contains exactly the vertices reachable from the source which form the source side
+	// of the minimum cut
+
+	double NetSourceOutflow = 0.0;
+	for (int32 Arc = Network.FirstArc[Source]; Arc < Network.FirstArc[Source + 1]; ++Arc)
+	{
+		NetSourceOutflow += Network.Flow(Arc);
+	}
+	MaxFlowValue = static_cast<float>(NetSourceOutflow);
+
+	for (int32 EdgeIndex = 0; EdgeIndex < NetworkEdges.Num(); ++EdgeIndex)
+	{
+		UGraphStructureEdge* Edge = NetworkEdges[EdgeIndex];
+		EdgeFlows.Add(Edge, static_cast<float>(Network.Flow(EdgeArcs[EdgeIndex])));
+
+		const bool bSourceSideReachable = Levels[NetworkEdgeEndpoints[EdgeIndex].X] != INDEX_NONE;
+		const bool bTargetSideReachable = Levels[NetworkEdgeEndpoints[EdgeIndex].Y] != INDEX_NONE;
+		if (bSourceSideReachable != bTargetSideReachable)
+		{
+			MinCutEdges.Add(Edge);
+		}
+	}
+
+	return MaxFlowValue;
+}
+
+void UGraphMaxFlowSolver::Reset()
+{
+	LastGraph = nullptr;
+	LastSource = nullptr;
+	LastSink = nullptr;
+	EdgeFlows.Empty();
+	MinCutEdges.Empty();
+	MaxFlowValue = 0.0f;
+}
+
+float UGraphMaxFlowSolver::GetMaxFlowValue() const
+{
+	return MaxFlowValue;
+}
+
+float UGraphMaxFlowSolver::GetEdgeFlow(UGraphStructureEdge* Edge) const
+{
+	const float* Flow = EdgeFlows.Find(Edge);
+	return Flow != nullptr ? *Flow : 0.0f;
+}
+
+TMap<UGraphStructureEdge*, float> UGraphMaxFlowSolver::GetEdgeFlows() const
+{
+	return EdgeFlows;
+}
+
+TSet<UGraphStructureEdge*> UGraphMaxFlowSolver::GetMinCutEdges() const
+{
+	return MinCutEdges;
+}
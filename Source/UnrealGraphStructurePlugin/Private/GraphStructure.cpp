@@ -3,31 +3,464 @@
 
 #include "GraphStructure.h"
 
+#include "Serialization/CustomVersion.h"
+
+namespace
+{
+	struct FGraphStructureCustomVersion
+	{
+		enum Type
+		{
+			BeforeCustomVersionWasAdded = 0,
+
+			// Vertex and edge attribute tables are serialized after the tagged properties
+			SerializedAttributeTables,
+
+			VersionPlusOne,
+			LatestVersion = VersionPlusOne - 1
+		};
+
+		static const FGuid GUID;
+	};
+
+	const FGuid FGraphStructureCustomVersion::GUID(0x5E2B7A41, 0x9C3D4F18, 0xA6E05B72, 0x1D84C39F);
+
+	FCustomVersionRegistration GRegisterGraphStructureCustomVersion(FGraphStructureCustomVersion::GUID,
+	                                                                FGraphStructureCustomVersion::LatestVersion,
+	                                                                TEXT("GraphStructureVer"));
+
+	// Remove an element from its dense array by moving the last element into its slot, keeping ids and attribute rows in sync
+	template <typename ElementType>
+	void RemoveDenseElement(TArray<ElementType*>& Elements, FGraphAttributeTable& Attributes, ElementType* Element)
+	{
+		const int32 GraphId = Element->GraphId;
+		check(Elements[GraphId] == Element);
+
+		Elements.RemoveAtSwap(GraphId, 1, EAllowShrinking::No);
+		if (Elements.IsValidIndex(GraphId))
+		{
+			Elements[GraphId]->GraphId = GraphId;
+		}
+		Attributes.RemoveRowSwap(GraphId);
+
+		Element->GraphId = INDEX_NONE;
+	}
+
+	template <typename T>
+	bool GetAttributeValue(const FGraphAttributeTable& Attributes, const int32 GraphId, const FName Name, T& Value)
+	{
+		const TConstArrayView<T> Column = Attributes.GetColumn<T>(Name);
+		if (!Column.IsValidIndex(GraphId))
+		{
+			return false;
+		}
+		Value = Column[GraphId];
+		return true;
+	}
+
+	template <typename T>
+	bool SetAttributeValue(FGraphAttributeTable& Attributes, const int32 GraphId, const FName Name, const T& Value)
+	{
+		const TArrayView<T> Column = Attributes.GetColumn<T>(Name);
+		if (!Column.IsValidIndex(GraphId))
+		{
+			return false;
+		}
+		Column[GraphId] = Value;
+		return true;
+	}
+
+	bool GetBoolAttributeValue(const FGraphAttributeTable& Attributes, const int32 GraphId, const FName Name, bool& Value)
+	{
+		const TBitArray<>* Column = Attributes.GetBoolColumn(Name);
+		if (Column == nullptr || !Column->IsValidIndex(GraphId))
+		{
+			return false;
+		}
+		Value = (*Column)[GraphId];
+		return true;
+	}
+
+	bool SetBoolAttributeValue(FGraphAttributeTable& Attributes, const int32 GraphId, const FName Name, const bool Value)
+	{
+		TBitArray<>* Column = Attributes.GetBoolColumn(Name);
+		if (Column == nullptr || !Column->IsValidIndex(GraphId))
+		{
+			return false;
+		}
+		(*Column)[GraphId] = Value;
+		return true;
+	}
+
+	template <typename FunctionType>
+	void ForEachNeighbour(const UGraphStructureVertex* Vertex, FunctionType Function)
+	{
+		for (const UGraphStructureEdge* Edge : Vertex->Adjacency)
+		{
+			check(Edge != nullptr);
+			Function(Edge->Source == Vertex ? Edge->Target : Edge->Source);
+		}
+	}
+
+	/**
+	 * Multi-source BFS running one search per bit of a lane mask over the dense vertex ids.
+	 * Every vertex holds the mask of searches that have seen it and the mask of searches that reached it on the current level, so a
+	 * vertex on the frontier of several searches is only expanded once per level for all of them.
+	 */
+	class FMultiSourceBfs
+	{
+	public:
+		using FLaneMask = uint64;
+
+		static constexpr int32 MaxLanes = 64;
+
+	private:
+		// Levels are only logged for path reconstruction, each entry holds the searches that reached the vertex on that level
+		struct FLevelEntry
+		{
+			FLaneMask Mask;
+			int32 Level;
+			int32 Next;
+		};
+
+		TConstArrayView<UGraphStructureVertex*> Vertices;
+
+		TArray<FLaneMask> Seen;
+		TArray<FLaneMask> Visit;
+		TArray<FLaneMask> VisitNext;
+
+		TArray<int32> Frontier;
+		TArray<int32> NextFrontier;
+
+		// Vertices seen by any search of the current run, used for collecting results and for resetting in time proportional to them
+		TArray<int32> Touched;
+
+		TArray<int32> LevelHeads;
+		TArray<FLevelEntry> LevelEntries;
+
+		void AddLevelEntry(const int32 VertexId, const int32 Level, const FLaneMask Mask)
+		{
+			LevelEntries.Add({Mask, Level, LevelHeads[VertexId]});
+			LevelHeads[VertexId] = LevelEntries.Num() - 1;
+		}
+
+		int32 FindLevel(const int32 VertexId, const FLaneMask LaneBit) const
+		{
+			for (int32 Entry = LevelHeads[VertexId]; Entry != INDEX_NONE; Entry = LevelEntries[Entry].Next)
+			{
+				if ((LevelEntries[Entry].Mask & LaneBit) != 0)
+				{
+					return LevelEntries[Entry].Level;
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		void Reset()
+		{
+			for (const int32 VertexId : Touched)
+			{
+				Seen[VertexId] = 0;
+				LevelHeads[VertexId] = INDEX_NONE;
+			}
+			Touched.Reset();
+			LevelEntries.Reset();
+		}
+
+	public:
+		explicit FMultiSourceBfs(const TConstArrayView<UGraphStructureVertex*> InVertices)
+			: Vertices(InVertices)
+		{
+			Seen.SetNumZeroed(Vertices.Num());
+			Visit.SetNumZeroed(Vertices.Num());
+			VisitNext.SetNumZeroed(Vertices.Num());
+			LevelHeads.Init(INDEX_NONE, Vertices.Num());
+		}
+
+		// Run one search per entry of SourceIds, entries that are INDEX_NONE are skipped. If TargetIds is not empty each search stops
+		// as soon as it has reached its target
+		void Run(const TConstArrayView<int32> SourceIds, const TConstArrayView<int32> TargetIds, const bool bLogLevels)
+		{
+			check(SourceIds.Num() <= MaxLanes);
+			check(TargetIds.IsEmpty() || TargetIds.Num() == SourceIds.Num());
+
+			Reset();
+			Frontier.Reset();
+
+			FLaneMask Active = 0;
+			for (int32 Lane = 0; Lane < SourceIds.Num(); ++Lane)
+			{
+				const int32 SourceId = SourceIds[Lane];
+				if (SourceId == INDEX_NONE)
+				{
+					continue;
+				}
+
+				const FLaneMask LaneBit = FLaneMask(1) << Lane;
+				if (Seen[SourceId] == 0)
+				{
+					Touched.Add(SourceId);
+					Frontier.Add(SourceId);
+				}
+				Seen[SourceId] |= LaneBit;
+				Visit[SourceId] |= LaneBit;
+				Active |= LaneBit;
+			}
+
+			auto RetireFinishedSearches = [&]()
+			{
+				for (int32 Lane = 0; Lane < TargetIds.Num(); ++Lane)
+				{
+					const FLaneMask LaneBit = FLaneMask(1) << Lane;
+					if ((Active & LaneBit) != 0 && TargetIds[Lane] != INDEX_NONE && (Seen[TargetIds[Lane]] & LaneBit) != 0)
+					{
+						Active &= ~LaneBit;
+					}
+				}
+			};
+
+			if (bLogLevels)
+			{
+				for (const int32 VertexId : Frontier)
+				{
+					AddLevelEntry(VertexId, 0, Visit[VertexId]);
+				}
+			}
+			RetireFinishedSearches();
+
+			for (int32 Level = 1; Active != 0 && !Frontier.IsEmpty(); ++Level)
+			{
+				NextFrontier.Reset();
+				for (const int32 VertexId : Frontier)
+				{
+					const FLaneMask Mask = Visit[VertexId] & Active;
+					Visit[VertexId] = 0;
+					if (Mask == 0)
+					{
+						continue;
+					}
+
+					ForEachNeighbour(Vertices[VertexId], [&](const UGraphStructureVertex* Neighbour)
+					{
+						const int32 NeighbourId = Neighbour->GraphId;
+						const FLaneMask NewLanes = Mask & ~Seen[NeighbourId];
+						if (NewLanes != 0)
+						{
+							if (VisitNext[NeighbourId] == 0)
+							{
+								NextFrontier.Add(NeighbourId);
+							}
+							VisitNext[NeighbourId] |= NewLanes;
+						}
+					});
+				}
+
+				for (const int32 VertexId : NextFrontier)
+				{
+					if (Seen[VertexId] == 0)
+					{
+						Touched.Add(VertexId);
+					}
+					Seen[VertexId] |= VisitNext[VertexId];
+					Visit[VertexId] = VisitNext[VertexId];
+					VisitNext[VertexId] = 0;
+
+					if (bLogLevels)
+					{
+						AddLevelEntry(VertexId, Level, Visit[VertexId]);
+					}
+				}
+
+				Swap(Frontier, NextFrontier);
+				RetireFinishedSearches();
+			}
+
+			// Searches that stopped early leave their last frontier behind
+			for (const int32 VertexId : Frontier)
+			{
+				Visit[VertexId] = 0;
+			}
+		}
+
+		TConstArrayView<int32> GetTouched() const
+		{
+			return Touched;
+		}
+
+		FLaneMask GetSeen(const int32 VertexId) const
+		{
+			return Seen[VertexId];
+		}
+
+		// Walk back from the target through neighbours the search reached one level earlier, requires levels to have been logged
+		bool ReconstructPath(const int32 Lane, const int32 TargetId, TArray<UGraphStructureVertex*>& Path) const
+		{
+			const FLaneMask LaneBit = FLaneMask(1) << Lane;
+			const int32 TargetLevel = FindLevel(TargetId, LaneBit);
+			if (TargetLevel == INDEX_NONE)
+			{
+				return false;
+			}
+
+			Path.SetNumUninitialized(TargetLevel + 1);
+			int32 CurrentId = TargetId;
+			Path[TargetLevel] = Vertices[CurrentId];
+			for (int32 Level = TargetLevel - 1; Level >= 0; --Level)
+			{
+				int32 ParentId = INDEX_NONE;
+				ForEachNeighbour(Vertices[CurrentId], [&](const UGraphStructureVertex* Neighbour)
+				{
+					if (ParentId == INDEX_NONE && FindLevel(Neighbour->GraphId, LaneBit) == Level)
+					{
+						ParentId = Neighbour->GraphId;
+					}
+				});
+				check(ParentId != INDEX_NONE);
+
+				CurrentId = ParentId;
+				Path[Level] = Vertices[CurrentId];
+			}
+			return true;
+		}
+	};
+}
+
 UGraphStructure::UGraphStructure()
 {
 }
 
+void UGraphStructure::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	Ar.UsingCustomVersion(FGraphStructureCustomVersion::GUID);
+	if (Ar.CustomVer(FGraphStructureCustomVersion::GUID) >= FGraphStructureCustomVersion::SerializedAttributeTables)
+	{
+		Ar << VertexAttributes;
+		Ar << EdgeAttributes;
+	}
+
+	if (Ar.IsLoading())
+	{
+		// Older graphs have no tables yet and get empty ones, tables that don't match the loaded elements are dropped
+		auto FitTable = [](FGraphAttributeTable& Attributes, const int32 NumElements)
+		{
+			if (Attributes.Num() != NumElements)
+			{
+				Attributes.Reset();
+				Attributes.AddRows(NumElements);
+			}
+		};
+		FitTable(VertexAttributes, Vertices.Num());
+		FitTable(EdgeAttributes, Edges.Num());
+	}
+}
+
+void UGraphStructure::PostLoad()
+{
+	Super::PostLoad();
+
+	RebuildAdjacency();
+}
+
+void UGraphStructure::PostDuplicate(const bool bDuplicateForPIE)
+{
+	Super::PostDuplicate(bDuplicateForPIE);
+
+	RebuildAdjacency();
+}
+
+void UGraphStructure::RebuildAdjacency()
+{
+	for (UGraphStructureVertex* Vertex : Vertices)
+	{
+		if (ensure(Vertex != nullptr))
+		{
+			Vertex->Adjacency.Empty();
+		}
+	}
+
+	for (UGraphStructureEdge* Edge : Edges)
+	{
+		if (ensure(Edge != nullptr) && ensure(Edge->Source != nullptr) && ensure(Edge->Target != nullptr))
+		{
+			Edge->Source->Adjacency.AddUnchecked(Edge);
+			if (Edge->Target != Edge->Source)
+			{
+				Edge->Target->Adjacency.AddUnchecked(Edge);
+			}
+		}
+	}
+}
+
 TSet<UGraphStructureVertex*> UGraphStructure::GetVertices()
 {
-	return Vertices;
+	return TSet<UGraphStructureVertex*>(Vertices);
 }
 
 TSet<UGraphStructureEdge*> UGraphStructure::GetEdges()
+{
+	return TSet<UGraphStructureEdge*>(Edges);
+}
+
+TConstArrayView<UGraphStructureVertex*> UGraphStructure::GetVertexArray() const
+{
+	return Vertices;
+}
+
+TConstArrayView<UGraphStructureEdge*> UGraphStructure::GetEdgeArray() const
 {
 	return Edges;
 }
 
+int32 UGraphStructure::GetNumVertices() const
+{
+	return Vertices.Num();
+}
+
+int32 UGraphStructure::GetNumEdges() const
+{
+	return Edges.Num();
+}
+
+UGraphStructureVertex* UGraphStructure::GetVertexById(const int32 GraphId) const
+{
+	return Vertices.IsValidIndex(GraphId) ? Vertices[GraphId] : nullptr;
+}
+
+UGraphStructureEdge* UGraphStructure::GetEdgeById(const int32 GraphId) const
+{
+	return Edges.IsValidIndex(GraphId) ? Edges[GraphId] : nullptr;
+}
+
+bool UGraphStructure::ContainsVertex(const UGraphStructureVertex* Vertex) const
+{
+	return Vertex != nullptr && Vertices.IsValidIndex(Vertex->GraphId) && Vertices[Vertex->GraphId] == Vertex;
+}
+
+bool UGraphStructure::ContainsEdge(const UGraphStructureEdge* Edge) const
+{
+	return Edge != nullptr && Edges.IsValidIndex(Edge->GraphId) && Edges[Edge->GraphId] == Edge;
+}
+
 bool UGraphStructure::AddVertex(UGraphStructureVertex* Vertex)
 {
 	if (ensure(Vertex != nullptr))
 	{
-		bool AlreadyInSet = false;
-		Vertices.Add(Vertex, &AlreadyInSet);
-		if (AlreadyInSet)
+		if (ContainsVertex(Vertex))
+		{
+			return false;
+		}
+
+		// Vertices store their own id, so they can only be part of one graph at a time
+		if (!ensureMsgf(Vertex->GraphId == INDEX_NONE, TEXT("Vertex is already part of another graph")))
 		{
 			return false;
 		}
 
+		Vertex->GraphId = Vertices.Add(Vertex);
+		VertexAttributes.AddRows(1);
+
 		OnVertexAdded.Broadcast(Vertex);
 		return true;
 	}
@@ -36,7 +469,7 @@ bool UGraphStructure::AddVertex(UGraphStructureVertex* Vertex)
 
 UGraphStructureVertex* UGraphStructure::AddDefaultVertex()
 {
-	UGraphStructureVertex* Vertex = NewObject<UGraphStructureVertex>();
+	UGraphStructureVertex* Vertex = NewObject<UGraphStructureVertex>(this);
 
 	// Since we have just created this vertex the addition should not fail
 	verify(AddVertex(Vertex));
@@ -48,16 +481,23 @@ bool UGraphStructure::AddEdge(UGraphStructureEdge* Edge)
 {
 	if (ensure(Edge != nullptr) && ensure(Edge->Source != nullptr) && ensure(Edge->Target != nullptr))
 	{
-		bool AlreadyInSet = false;
-		Edges.Add(Edge, &AlreadyInSet);
+		if (ContainsEdge(Edge))
+		{
+			return false;
+		}
 
-		Edge->Source->Edges.Add(Edge);
-		Edge->Target->Edges.Add(Edge);
-		if (AlreadyInSet)
+		// Edges store their own id, so they can only be part of one graph at a time
+		if (!ensureMsgf(Edge->GraphId == INDEX_NONE, TEXT("Edge is already part of another graph")))
 		{
 			return false;
 		}
 
+		Edge->GraphId = Edges.Add(Edge);
+		EdgeAttributes.AddRows(1);
+
+		Edge->Source->Adjacency.Add(Edge);
+		Edge->Target->Adjacency.Add(Edge);
+
 		OnEdgeAdded.Broadcast(Edge);
 		return true;
 	}
@@ -66,7 +506,7 @@ bool UGraphStructure::AddEdge(UGraphStructureEdge* Edge)
 
 UGraphStructureEdge* UGraphStructure::AddDefaultEdgeBetween(UGraphStructureVertex* SourceVertex, UGraphStructureVertex* TargetVertex)
 {
-	UGraphStructureEdge* Edge = NewObject<UGraphStructureEdge>();
+	UGraphStructureEdge* Edge = NewObject<UGraphStructureEdge>(this);
 	Edge->Source = SourceVertex;
 	Edge->Target = TargetVertex;
 
@@ -76,23 +516,184 @@ UGraphStructureEdge* UGraphStructure::AddDefaultEdgeBetween(UGraphStructureVerte
 	return Edge;
 }
 
+bool UGraphStructure::AddBulk(int32 NumNewVertices, TConstArrayView<FIntPoint> EdgeEndpoints, TArray<UGraphStructureVertex*>& NewVertices,
+                              TArray<UGraphStructureEdge*>& NewEdges)
+{
+	check(NewVertices.IsEmpty());
+	check(NewEdges.IsEmpty());
+	if (!ensure(NumNewVertices >= 0))
+	{
+		return false;
+	}
+
+	const int32 NumVerticesAfter = Vertices.Num() + NumNewVertices;
+
+	// Validate all endpoints before adding anything, so invalid input leaves the graph untouched
+	for (const FIntPoint& Endpoints : EdgeEndpoints)
+	{
+		if (static_cast<uint32>(Endpoints.X) >= static_cast<uint32>(NumVerticesAfter) ||
+			static_cast<uint32>(Endpoints.Y) >= static_cast<uint32>(NumVerticesAfter))
+		{
+			ensureMsgf(false, TEXT("Edge endpoint ids %d, %d out of range"), Endpoints.X, Endpoints.Y);
+			return false;
+		}
+	}
+
+	// Vertices
+
+	Vertices.Reserve(NumVerticesAfter);
+	VertexAttributes.Reserve(NumVerticesAfter);
+	NewVertices.Reserve(NumNewVertices);
+	for (int32 i = 0; i < NumNewVertices; ++i)
+	{
+		UGraphStructureVertex* Vertex = NewObject<UGraphStructureVertex>(this);
+		Vertex->GraphId = Vertices.Add(Vertex);
+		NewVertices.Add(Vertex);
+	}
+	VertexAttributes.AddRows(NumNewVertices);
+
+	// Edges, count the added degree of every vertex first so each adjacency set grows only once
+
+	TArray<int32> AddedDegrees;
+	AddedDegrees.SetNumZeroed(NumVerticesAfter);
+	for (const FIntPoint& Endpoints : EdgeEndpoints)
+	{
+		++AddedDegrees[Endpoints.X];
+		if (Endpoints.X != Endpoints.Y)
+		{
+			++AddedDegrees[Endpoints.Y];
+		}
+	}
+	for (int32 VertexId = 0; VertexId < NumVerticesAfter; ++VertexId)
+	{
+		if (AddedDegrees[VertexId] > 0)
+		{
+			FGraphVertexAdjacency& VertexEdges = Vertices[VertexId]->Adjacency;
+			VertexEdges.Reserve(VertexEdges.Num() + AddedDegrees[VertexId]);
+		}
+	}
+
+	Edges.Reserve(Edges.Num() + EdgeEndpoints.Num());
+	EdgeAttributes.Reserve(Edges.Num() + EdgeEndpoints.Num());
+	NewEdges.Reserve(EdgeEndpoints.Num());
+	for (const FIntPoint& Endpoints : EdgeEndpoints)
+	{
+		UGraphStructureEdge* Edge = NewObject<UGraphStructureEdge>(this);
+		Edge->Source = Vertices[Endpoints.X];
+		Edge->Target = Vertices[Endpoints.Y];
+		Edge->GraphId = Edges.Add(Edge);
+
+		// The edge is new, so the duplicate lookup of Add can be skipped
+		Edge->Source->Adjacency.AddUnchecked(Edge);
+		if (Edge->Target != Edge->Source)
+		{
+			Edge->Target->Adjacency.AddUnchecked(Edge);
+		}
+		NewEdges.Add(Edge);
+	}
+	EdgeAttributes.AddRows(EdgeEndpoints.Num());
+
+	OnBulkAdded.Broadcast(NewVertices, NewEdges);
+	return true;
+}
+
+TArray<UGraphStructureVertex*> UGraphStructure::AddVerticesBulk(int32 Count)
+{
+	TArray<UGraphStructureVertex*> NewVertices;
+	TArray<UGraphStructureEdge*> NewEdges;
+	AddBulk(Count, TConstArrayView<FIntPoint>(), NewVertices, NewEdges);
+	return NewVertices;
+}
+
+TArray<UGraphStructureEdge*> UGraphStructure::AddEdgesBulk(TConstArrayView<FIntPoint> EdgeEndpoints)
+{
+	TArray<UGraphStructureVertex*> NewVertices;
+	TArray<UGraphStructureEdge*> NewEdges;
+	AddBulk(0, EdgeEndpoints, NewVertices, NewEdges);
+	return NewEdges;
+}
+
+TArray<UGraphStructureEdge*> UGraphStructure::K2_AddEdgesBulk(const TArray<FIntPoint>& EdgeEndpoints)
+{
+	return AddEdgesBulk(EdgeEndpoints);
+}
+
+UGraphStructure* UGraphStructure::FromAdjacencyList(TConstArrayView<TArray<int32>> AdjacencyList, UObject* Outer)
+{
+	const int32 NumVertices = AdjacencyList.Num();
+
+	int32 NumEntries = 0;
+	for (const TArray<int32>& Neighbours : AdjacencyList)
+	{
+		NumEntries += Neighbours.Num();
+	}
+
+	// Symmetric lists contain every edge twice, except self-loops
+	TArray<FIntPoint> EdgeEndpoints;
+	EdgeEndpoints.Reserve(NumEntries / 2 + 1);
+	for (int32 VertexId = 0; VertexId < NumVertices; ++VertexId)
+	{
+		for (const int32 NeighbourId : AdjacencyList[VertexId])
+		{
+			if (!ensureMsgf(NeighbourId >= 0 && NeighbourId < NumVertices, TEXT("Adjacency list entry %d out of range"), NeighbourId))
+			{
+				return nullptr;
+			}
+			if (NeighbourId >= VertexId)
+			{
+				EdgeEndpoints.Emplace(VertexId, NeighbourId);
+			}
+		}
+	}
+
+	UGraphStructure* Graph = NewObject<UGraphStructure>(Outer != nullptr ? Outer : GetTransientPackage());
+
+	TArray<UGraphStructureVertex*> NewVertices;
+	TArray<UGraphStructureEdge*> NewEdges;
+	verify(Graph->AddBulk(NumVertices, EdgeEndpoints, NewVertices, NewEdges));
+
+	return Graph;
+}
+
 bool UGraphStructure::RemoveVertex(UGraphStructureVertex* Vertex)
 {
-	if (!Vertices.Contains(Vertex))
+	if (!ContainsVertex(Vertex))
 	{
 		return false;
 	}
 
 	if (ensure(Vertex != nullptr))
 	{
-		// Copy TSet first to avoid modifying Set while iterating
-		for (UGraphStructureEdge* Edge : Vertex->Edges.Array())
+		// Detach all edges first and report them in a single event, so listeners can handle all of them at once
+		TArray<UGraphStructureEdge*> DetachedEdges = Vertex->Adjacency.Array();
+		for (UGraphStructureEdge* Edge : DetachedEdges)
 		{
-			// If RemoveEdge is false halt since there is something wrong with our graph
-			verify(RemoveEdge(Edge));
+			check(Edge != nullptr);
+			check(Edge->Source == Vertex || Edge->Target == Vertex);
+
+			UGraphStructureVertex* OtherVertex = Edge->Source == Vertex ? Edge->Target : Edge->Source;
+			// If the removal fails halt since there is something wrong with our graph, ignore self-loops
+			verify(OtherVertex->Adjacency.Remove(Edge) || OtherVertex == Vertex);
+
+			RemoveDenseElement(Edges, EdgeAttributes, Edge);
+		}
+		Vertex->Adjacency.Empty();
+
+		if (!DetachedEdges.IsEmpty())
+		{
+			// Restored when done so a listener removing another vertex in between doesn't break the tracking
+			TGuardValue<UGraphStructureVertex*> RemovingVertexGuard(RemovingVertex, Vertex);
+
+			OnVertexEdgesRemoved.Broadcast(Vertex, DetachedEdges);
+
+			// Still report every edge on its own for listeners that only care about single edges
+			for (UGraphStructureEdge* Edge : DetachedEdges)
+			{
+				OnEdgeRemoved.Broadcast(Edge);
+			}
 		}
 
-		verify(Vertices.Remove(Vertex) > 0);
+		RemoveDenseElement(Vertices, VertexAttributes, Vertex);
 
 		OnVertexRemoved.Broadcast(Vertex);
 
@@ -103,18 +704,18 @@ bool UGraphStructure::RemoveVertex(UGraphStructureVertex* Vertex)
 
 bool UGraphStructure::RemoveEdge(UGraphStructureEdge* Edge)
 {
-	if (!Edges.Contains(Edge))
+	if (!ContainsEdge(Edge))
 	{
 		return false;
 	}
 
 	if (ensure(Edge != nullptr) && ensure(Edge->Source != nullptr) && ensure(Edge->Target != nullptr))
 	{
-		// Remove edge from both source and target vertices Edges TSet, if edge is self-loop ignore second removal result
-		verify(Edge->Source->Edges.Remove(Edge));
-		verify(Edge->Target->Edges.Remove(Edge) || Edge->Source == Edge->Target);
+		// Remove edge from both source and target vertices adjacency, if edge is self-loop ignore second removal result
+		verify(Edge->Source->Adjacency.Remove(Edge));
+		verify(Edge->Target->Adjacency.Remove(Edge) || Edge->Source == Edge->Target);
 
-		verify(Edges.Remove(Edge));
+		RemoveDenseElement(Edges, EdgeAttributes, Edge);
 
 		OnEdgeRemoved.Broadcast(Edge);
 
@@ -123,6 +724,11 @@ bool UGraphStructure::RemoveEdge(UGraphStructureEdge* Edge)
 	return false;
 }
 
+bool UGraphStructure::IsRemovedWithVertex(const UGraphStructureEdge* Edge) const
+{
+	return RemovingVertex != nullptr && Edge != nullptr && (Edge->Source == RemovingVertex || Edge->Target == RemovingVertex);
+}
+
 UGraphStructureEdge* UGraphStructure::GetEdgeBetween(UGraphStructureVertex* SourceVertex, UGraphStructureVertex* TargetVertex)
 {
 	for (UGraphStructureEdge* Edge : GetAllEdgesBetween(SourceVertex, TargetVertex))
@@ -136,7 +742,21 @@ TSet<UGraphStructureEdge*> UGraphStructure::GetAllEdgesBetween(UGraphStructureVe
 {
 	if (ensure(SourceVertex != nullptr) && ensure(TargetVertex != nullptr))
 	{
-		return SourceVertex->Edges.Intersect(TargetVertex->Edges);
+		// Scan the vertex with fewer edges, each edge found there only has to be checked for its other endpoint
+		const bool bScanSource = SourceVertex->Adjacency.Num() <= TargetVertex->Adjacency.Num();
+		const UGraphStructureVertex* ScanVertex = bScanSource ? SourceVertex : TargetVertex;
+		const UGraphStructureVertex* OtherVertex = bScanSource ? TargetVertex : SourceVertex;
+
+		TSet<UGraphStructureEdge*> EdgesBetween;
+		for (UGraphStructureEdge* Edge : ScanVertex->Adjacency)
+		{
+			check(Edge != nullptr);
+			if ((Edge->Source == ScanVertex ? Edge->Target : Edge->Source) == OtherVertex)
+			{
+				EdgesBetween.Add(Edge);
+			}
+		}
+		return EdgesBetween;
 	}
 	TSet<UGraphStructureEdge*> EmptySet;
 	return EmptySet;
@@ -169,7 +789,7 @@ TSet<UGraphStructureVertex*> UGraphStructure::FindAllConnectedVertices(UGraphStr
 		verify(Queue.Dequeue(NextNode));
 		check(NextNode != nullptr);
 
-		for (const UGraphStructureEdge* Edge : NextNode->Edges)
+		for (const UGraphStructureEdge* Edge : NextNode->Adjacency)
 		{
 			check(Edge != nullptr);
 
@@ -213,7 +833,7 @@ bool UGraphStructure::BfsShortestPath(UGraphStructureVertex* SourceVertex, UGrap
 		verify(Queue.Dequeue(NextNode));
 		check(NextNode != nullptr);
 
-		for (const UGraphStructureEdge* Edge : NextNode->Edges)
+		for (const UGraphStructureEdge* Edge : NextNode->Adjacency)
 		{
 			check(Edge != nullptr);
 
@@ -268,6 +888,348 @@ bool UGraphStructure::BfsShortestPath(UGraphStructureVertex* SourceVertex, UGrap
 	return true;
 }
 
+TArray<FGraphVertexSet> UGraphStructure::BatchedFindAllConnectedVertices(const TArray<UGraphStructureVertex*>& RootVertices)
+{
+	TArray<FGraphVertexSet> Results;
+	Results.SetNum(RootVertices.Num());
+
+	FMultiSourceBfs Bfs(Vertices);
+	TArray<int32, TInlineAllocator<FMultiSourceBfs::MaxLanes>> SourceIds;
+
+	for (int32 BatchStart = 0; BatchStart < RootVertices.Num(); BatchStart += FMultiSourceBfs::MaxLanes)
+	{
+		const int32 BatchNum = FMath::Min(FMultiSourceBfs::MaxLanes, RootVertices.Num() - BatchStart);
+
+		SourceIds.Reset();
+		for (int32 Lane = 0; Lane < BatchNum; ++Lane)
+		{
+			UGraphStructureVertex* RootVertex = RootVertices[BatchStart + Lane];
+			SourceIds.Add(ContainsVertex(RootVertex) ? RootVertex->GraphId : INDEX_NONE);
+		}
+
+		Bfs.Run(SourceIds, {}, false);
+
+		for (const int32 VertexId : Bfs.GetTouched())
+		{
+			for (FMultiSourceBfs::FLaneMask Mask = Bfs.GetSeen(VertexId); Mask != 0; Mask &= Mask - 1)
+			{
+				const int32 Lane = FMath::CountTrailingZeros64(Mask);
+				Results[BatchStart + Lane].Vertices.Add(Vertices[VertexId]);
+			}
+		}
+	}
+
+	return Results;
+}
+
+TArray<FGraphVertexPath> UGraphStructure::BatchedBfsShortestPaths(const TArray<UGraphStructureVertex*>& SourceVertices,
+                                                                  const TArray<UGraphStructureVertex*>& TargetVertices)
+{
+	TArray<FGraphVertexPath> Results;
+	if (!ensureMsgf(SourceVertices.Num() == TargetVertices.Num(), TEXT("Every source vertex needs a target vertex")))
+	{
+		return Results;
+	}
+	Results.SetNum(SourceVertices.Num());
+
+	FMultiSourceBfs Bfs(Vertices);
+	TArray<int32, TInlineAllocator<FMultiSourceBfs::MaxLanes>> SourceIds;
+	TArray<int32, TInlineAllocator<FMultiSourceBfs::MaxLanes>> TargetIds;
+
+	for (int32 BatchStart = 0; BatchStart < SourceVertices.Num(); BatchStart += FMultiSourceBfs::MaxLanes)
+	{
+		const int32 BatchNum = FMath::Min(FMultiSourceBfs::MaxLanes, SourceVertices.Num() - BatchStart);
+
+		SourceIds.Reset();
+		TargetIds.Reset();
+		for (int32 Lane = 0; Lane < BatchNum; ++Lane)
+		{
+			UGraphStructureVertex* SourceVertex = SourceVertices[BatchStart + Lane];
+			UGraphStructureVertex* TargetVertex = TargetVertices[BatchStart + Lane];
+			const bool bValidQuery = ContainsVertex(SourceVertex) && ContainsVertex(TargetVertex);
+			SourceIds.Add(bValidQuery ? SourceVertex->GraphId : INDEX_NONE);
+			TargetIds.Add(bValidQuery ? TargetVertex->GraphId : INDEX_NONE);
+		}
+
+		Bfs.Run(SourceIds, TargetIds, true);
+
+		for (int32 Lane = 0; Lane < BatchNum; ++Lane)
+		{
+			if (TargetIds[Lane] != INDEX_NONE)
+			{
+				Bfs.ReconstructPath(Lane, TargetIds[Lane], Results[BatchStart + Lane].Vertices);
+			}
+		}
+	}
+
+	return Results;
+}
+
+bool UGraphStructure::DijkstraShortestPath(UGraphStructureVertex* SourceVertex, UGraphStructureVertex* TargetVertex, FName WeightAttribute,
+                                           TArray<UGraphStructureVertex*>& ShortestPath, float& PathLength)
+{
+	check(ShortestPath.IsEmpty());
+	PathLength = 0.0f;
+	if (!ContainsVertex(SourceVertex) || !ContainsVertex(TargetVertex))
+	{
+		return false;
+	}
+
+	TConstArrayView<float> WeightColumn;
+	if (!WeightAttribute.IsNone())
+	{
+		if (!ensureMsgf(EdgeAttributes.HasColumn(WeightAttribute, EGraphAttributeType::Float), TEXT("No edge float attribute %s"),
+		                *WeightAttribute.ToString()))
+		{
+			return false;
+		}
+		WeightColumn = EdgeAttributes.GetColumn<float>(WeightAttribute);
+	}
+
+	struct FQueueEntry
+	{
+		float Distance;
+		int32 VertexId;
+	};
+	auto QueuePredicate = [](const FQueueEntry& A, const FQueueEntry& B) { return A.Distance < B.Distance; };
+
+	TArray<float> Distances;
+	Distances.Init(TNumericLimits<float>::Max(), Vertices.Num());
+	TArray<UGraphStructureEdge*> ParentEdges;
+	ParentEdges.Init(nullptr, Vertices.Num());
+	TArray<FQueueEntry> Queue;
+
+	Distances[SourceVertex->GraphId] = 0.0f;
+	Queue.HeapPush({0.0f, SourceVertex->GraphId}, QueuePredicate);
+
+	while (!Queue.IsEmpty())
+	{
+		FQueueEntry Entry;
+		Queue.HeapPop(Entry, QueuePredicate, EAllowShrinking::No);
+
+		// Vertices are queued again instead of decreasing their key, skip outdated entries
+		if (Entry.Distance > Distances[Entry.VertexId])
+		{
+			continue;
+		}
+		if (Entry.VertexId == TargetVertex->GraphId)
+		{
+			break;
+		}
+
+		const UGraphStructureVertex* NextNode = Vertices[Entry.VertexId];
+		for (UGraphStructureEdge* Edge : NextNode->Adjacency)
+		{
+			check(Edge != nullptr);
+
+			const UGraphStructureVertex* Neighbour = Edge->Source == NextNode ? Edge->Target : Edge->Source;
+			const float Weight = FMath::Max(WeightColumn.Num() > 0 ? WeightColumn[Edge->GraphId] : Edge->Weight, 0.0f);
+			const float Distance = Entry.Distance + Weight;
+			if (Distance < Distances[Neighbour->GraphId])
+			{
+				Distances[Neighbour->GraphId] = Distance;
+				ParentEdges[Neighbour->GraphId] = Edge;
+				Queue.HeapPush({Distance, Neighbour->GraphId}, QueuePredicate);
+			}
+		}
+	}
+
+	if (SourceVertex != TargetVertex && ParentEdges[TargetVertex->GraphId] == nullptr)
+	{
+		return false;
+	}
+
+	// Backtrack ParentEdges to find path
+	UGraphStructureVertex* CurrentVertex = TargetVertex;
+	while (CurrentVertex != SourceVertex)
+	{
+		ShortestPath.Add(CurrentVertex);
+
+		const UGraphStructureEdge* ParentEdge = ParentEdges[CurrentVertex->GraphId];
+		CurrentVertex = ParentEdge->Source == CurrentVertex ? ParentEdge->Target : ParentEdge->Source;
+	}
+	ShortestPath.Add(SourceVertex);
+	Algo::Reverse(ShortestPath);
+
+	PathLength = Distances[TargetVertex->GraphId];
+	return true;
+}
+
+FGraphAttributeTable& UGraphStructure::GetVertexAttributes()
+{
+	return VertexAttributes;
+}
+
+const FGraphAttributeTable& UGraphStructure::GetVertexAttributes() const
+{
+	return VertexAttributes;
+}
+
+FGraphAttributeTable& UGraphStructure::GetEdgeAttributes()
+{
+	return EdgeAttributes;
+}
+
+const FGraphAttributeTable& UGraphStructure::GetEdgeAttributes() const
+{
+	return EdgeAttributes;
+}
+
+bool UGraphStructure::AddVertexAttribute(FName Name, EGraphAttributeType Type)
+{
+	return VertexAttributes.AddColumn(Name, Type);
+}
+
+bool UGraphStructure::AddEdgeAttribute(FName Name, EGraphAttributeType Type)
+{
+	return EdgeAttributes.AddColumn(Name, Type);
+}
+
+bool UGraphStructure::RemoveVertexAttribute(FName Name)
+{
+	return VertexAttributes.RemoveColumn(Name);
+}
+
+bool UGraphStructure::RemoveEdgeAttribute(FName Name)
+{
+	return EdgeAttributes.RemoveColumn(Name);
+}
+
+bool UGraphStructure::GetVertexFloatAttribute(UGraphStructureVertex* Vertex, FName Name, float& Value) const
+{
+	return ContainsVertex(Vertex) && GetAttributeValue(VertexAttributes, Vertex->GraphId, Name, Value);
+}
+
+bool UGraphStructure::SetVertexFloatAttribute(UGraphStructureVertex* Vertex, FName Name, float Value)
+{
+	return ContainsVertex(Vertex) && SetAttributeValue(VertexAttributes, Vertex->GraphId, Name, Value);
+}
+
+bool UGraphStructure::GetEdgeFloatAttribute(UGraphStructureEdge* Edge, FName Name, float& Value) const
+{
+	return ContainsEdge(Edge) && GetAttributeValue(EdgeAttributes, Edge->GraphId, Name, Value);
+}
+
+bool UGraphStructure::SetEdgeFloatAttribute(UGraphStructureEdge* Edge, FName Name, float Value)
+{
+	return ContainsEdge(Edge) && SetAttributeValue(EdgeAttributes, Edge->GraphId, Name, Value);
+}
+
+bool UGraphStructure::GetVertexIntAttribute(UGraphStructureVertex* Vertex, FName Name, int32& Value) const
+{
+	return ContainsVertex(Vertex) && GetAttributeValue(VertexAttributes, Vertex->GraphId, Name, Value);
+}
+
+bool UGraphStructure::SetVertexIntAttribute(UGraphStructureVertex* Vertex, FName Name, int32 Value)
+{
+	return ContainsVertex(Vertex) && SetAttributeValue(VertexAttributes, Vertex->GraphId, Name, Value);
+}
+
+bool UGraphStructure::GetEdgeIntAttribute(UGraphStructureEdge* Edge, FName Name, int32& Value) const
+{
+	return ContainsEdge(Edge) && GetAttributeValue(EdgeAttributes, Edge->GraphId, Name, Value);
+}
+
+bool UGraphStructure::SetEdgeIntAttribute(UGraphStructureEdge* Edge, FName Name, int32 Value)
+{
+	return ContainsEdge(Edge) && SetAttributeValue(EdgeAttributes, Edge->GraphId, Name, Value);
+}
+
+bool UGraphStructure::GetVertexVectorAttribute(UGraphStructureVertex* Vertex, FName Name, FVector& Value) const
+{
+	return ContainsVertex(Vertex) && GetAttributeValue(VertexAttributes, Vertex->GraphId, Name, Value);
+}
+
+bool UGraphStructure::SetVertexVectorAttribute(UGraphStructureVertex* Vertex, FName Name, FVector Value)
+{
+	return ContainsVertex(Vertex) && SetAttributeValue(VertexAttributes, Vertex->GraphId, Name, Value);
+}
+
+bool UGraphStructure::GetEdgeVectorAttribute(UGraphStructureEdge* Edge, FName Name, FVector& Value) const
+{
+	return ContainsEdge(Edge) && GetAttributeValue(EdgeAttributes, Edge->GraphId, Name, Value);
+}
+
+bool UGraphStructure::SetEdgeVectorAttribute(UGraphStructureEdge* Edge, FName Name, FVector Value)
+{
+	return ContainsEdge(Edge) && SetAttributeValue(EdgeAttributes, Edge->GraphId, Name, Value);
+}
+
+bool UGraphStructure::GetVertexBoolAttribute(UGraphStructureVertex* Vertex, FName Name, bool& Value) const
+{
+	return ContainsVertex(Vertex) && GetBoolAttributeValue(VertexAttributes, Vertex->GraphId, Name, Value);
+}
+
+bool UGraphStructure::SetVertexBoolAttribute(UGraphStructureVertex* Vertex, FName Name, bool Value)
+{
+	return ContainsVertex(Vertex) && SetBoolAttributeValue(VertexAttributes, Vertex->GraphId, Name, Value);
+}
+
+bool UGraphStructure::GetEdgeBoolAttribute(UGraphStructureEdge* Edge, FName Name, bool& Value) const
+{
+	return ContainsEdge(Edge) && GetBoolAttributeValue(EdgeAttributes, Edge->GraphId, Name, Value);
+}
+
+bool UGraphStructure::SetEdgeBoolAttribute(UGraphStructureEdge* Edge, FName Name, bool Value)
+{
+	return ContainsEdge(Edge) && SetBoolAttributeValue(EdgeAttributes, Edge->GraphId, Name, Value);
+}
+
+bool UGraphStructure::ScaleVertexFloatAttribute(FName Name, float Factor)
+{
+	return VertexAttributes.ScaleFloatColumn(Name, Factor);
+}
+
+bool UGraphStructure::ScaleEdgeFloatAttribute(FName Name, float Factor)
+{
+	return EdgeAttributes.ScaleFloatColumn(Name, Factor);
+}
+
+double UGraphStructure::SumVertexFloatAttribute(FName Name) const
+{
+	return VertexAttributes.SumFloatColumn(Name);
+}
+
+double UGraphStructure::SumEdgeFloatAttribute(FName Name) const
+{
+	return EdgeAttributes.SumFloatColumn(Name);
+}
+
+SIZE_T UGraphStructure::GetAllocatedSize() const
+{
+	SIZE_T Size = Vertices.GetAllocatedSize() + Edges.GetAllocatedSize();
+	Size += VertexAttributes.GetAllocatedSize() + EdgeAttributes.GetAllocatedSize();
+	for (const UGraphStructureVertex* Vertex : Vertices)
+	{
+		Size += Vertex->GetClass()->GetStructureSize() + Vertex->Adjacency.GetAllocatedSize();
+	}
+	for (const UGraphStructureEdge* Edge : Edges)
+	{
+		Size += Edge->GetClass()->GetStructureSize();
+	}
+	return Size;
+}
+
+void UGraphStructure::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetAllocatedSize());
+}
+
+void UGraphStructure::Shrink()
+{
+	Vertices.Shrink();
+	Edges.Shrink();
+	VertexAttributes.Shrink();
+	EdgeAttributes.Shrink();
+
+	for (UGraphStructureVertex* Vertex : Vertices)
+	{
+		Vertex->Adjacency.Shrink();
+	}
+}
+
 FString UGraphStructure::ExportGraphvizDotString(FString Name)
 {
 	auto ConvertMap = [](TMap<FString, FString> Map) -> FString
@@ -288,18 +1250,14 @@ FString UGraphStructure::ExportGraphvizDotString(FString Name)
 
 	FString DotString = FString(TEXT("graph ")) + Name + "{\n";
 
-	TMap<UGraphStructureVertex*, int32> VerticesIds;
-	int32 i = 0;
 	for (UGraphStructureVertex* Vertex : Vertices)
 	{
-		VerticesIds.Add(Vertex, i);
-		DotString += FString::FromInt(i) + ConvertMap(Vertex->GetGraphvizDotAttributes()) + ";\n";
-		++i;
+		DotString += FString::FromInt(Vertex->GraphId) + ConvertMap(Vertex->GetGraphvizDotAttributes()) + ";\n";
 	}
 	for (UGraphStructureEdge* Edge : Edges)
 	{
-		const int32 SourceId = VerticesIds.FindChecked(Edge->Source);
-		const int32 TargetId = VerticesIds.FindChecked(Edge->Target);
+		const int32 SourceId = Edge->Source->GraphId;
+		const int32 TargetId = Edge->Target->GraphId;
 		DotString += FString::FromInt(SourceId) + "--" + FString::FromInt(TargetId) + ConvertMap(Edge->GetGraphvizDotAttributes()) + ";\n";
 	}
 	DotString += "}";
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GraphStructure.h"
+#include "ConnectedComponents/GraphConnectedComponentsMonitor.h"
+#include "SpanningForest/GraphSpanningForestMonitor.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	double ToKiB(const SIZE_T Bytes)
+	{
+		return static_cast<double>(Bytes) / 1024.0;
+	}
+
+	void DumpGraphStructureMemory(FOutputDevice& Ar)
+	{
+		SIZE_T TotalSize = 0;
+
+		// Class default objects are excluded, they are no live instances
+
+		for (TObjectIterator<UGraphStructure> It(RF_ClassDefaultObject); It; ++It)
+		{
+			const SIZE_T Size = It->GetAllocatedSize();
+			Ar.Logf(TEXT("Graph %s: %d vertices, %d edges, %.1f KiB"), *It->GetPathName(), It->GetNumVertices(), It->GetNumEdges(),
+			        ToKiB(Size));
+			TotalSize += Size;
+		}
+
+		for (TObjectIterator<UGraphConnectedComponentsMonitor> It(RF_ClassDefaultObject); It; ++It)
+		{
+			const SIZE_T Size = It->GetAllocatedSize();
+			Ar.Logf(TEXT("ConnectedComponentsMonitor %s: %.1f KiB"), *It->GetPathName(), ToKiB(Size));
+			TotalSize += Size;
+		}
+
+		for (TObjectIterator<UGraphSpanningForestMonitor> It(RF_ClassDefaultObject); It; ++It)
+		{
+			const SIZE_T Size = It->GetAllocatedSize();
+			Ar.Logf(TEXT("SpanningForestMonitor %s: %.1f KiB"), *It->GetPathName(), ToKiB(Size));
+			TotalSize += Size;
+		}
+
+		Ar.Logf(TEXT("Total: %.1f KiB"), ToKiB(TotalSize));
+	}
+
+	FAutoConsoleCommandWithOutputDevice DumpMemoryCommand(
+		TEXT("GraphStructure.DumpMemory"),
+		TEXT("Log the memory allocated by every graph, connected components monitor and spanning forest monitor"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&DumpGraphStructureMemory));
+}
@@ -3,6 +3,20 @@
 
 #include "GraphStructureVertex.h"
 
+#include "GraphStructureEdge.h"
+
 UGraphStructureVertex::UGraphStructureVertex()
 {
 }
+
+void UGraphStructureVertex::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	CastChecked<UGraphStructureVertex>(InThis)->Adjacency.AddReferencedObjects(Collector, InThis);
+
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
+TSet<UGraphStructureEdge*> UGraphStructureVertex::GetEdges() const
+{
+	return TSet<UGraphStructureEdge*>(Adjacency.Array());
+}
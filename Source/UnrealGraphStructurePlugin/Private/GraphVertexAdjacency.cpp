@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GraphVertexAdjacency.h"
+
+#include "GraphStructureEdge.h"
+
+int32 FGraphVertexAdjacency::Find(const UGraphStructureEdge* Edge) const
+{
+	if (EdgeIndices.IsValid())
+	{
+		const int32* Index = EdgeIndices->Find(const_cast<UGraphStructureEdge*>(Edge));
+		return Index != nullptr ? *Index : INDEX_NONE;
+	}
+	return Edges.IndexOfByKey(Edge);
+}
+
+void FGraphVertexAdjacency::BuildEdgeIndices()
+{
+	if (!EdgeIndices.IsValid())
+	{
+		EdgeIndices = MakeUnique<TMap<UGraphStructureEdge*, int32>>();
+	}
+
+	EdgeIndices->Reset();
+	EdgeIndices->Reserve(Edges.Num());
+	for (int32 Index = 0; Index < Edges.Num(); ++Index)
+	{
+		EdgeIndices->Add(Edges[Index], Index);
+	}
+}
+
+bool FGraphVertexAdjacency::Add(UGraphStructureEdge* Edge)
+{
+	if (Find(Edge) != INDEX_NONE)
+	{
+		return false;
+	}
+
+	AddUnchecked(Edge);
+	return true;
+}
+
+void FGraphVertexAdjacency::AddUnchecked(UGraphStructureEdge* Edge)
+{
+	checkSlow(Find(Edge) == INDEX_NONE);
+
+	const int32 Index = Edges.Add(Edge);
+	if (EdgeIndices.IsValid())
+	{
+		EdgeIndices->Add(Edge, Index);
+	}
+	else if (Edges.Num() > HashThreshold)
+	{
+		BuildEdgeIndices();
+	}
+}
+
+bool FGraphVertexAdjacency::Remove(const UGraphStructureEdge* Edge)
+{
+	const int32 Index = Find(Edge);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Edges.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (EdgeIndices.IsValid())
+	{
+		EdgeIndices->Remove(const_cast<UGraphStructureEdge*>(Edge));
+		if (Edges.IsValidIndex(Index))
+		{
+			EdgeIndices->FindChecked(Edges[Index]) = Index;
+		}
+	}
+	return true;
+}
+
+bool FGraphVertexAdjacency::Contains(const UGraphStructureEdge* Edge) const
+{
+	return Find(Edge) != INDEX_NONE;
+}
+
+TArray<UGraphStructureEdge*> FGraphVertexAdjacency::Array() const
+{
+	return TArray<UGraphStructureEdge*>(Edges.GetData(), Edges.Num());
+}
+
+void FGraphVertexAdjacency::Empty()
+{
+	Edges.Empty();
+	EdgeIndices.Reset();
+}
+
+void FGraphVertexAdjacency::Reserve(const int32 Number)
+{
+	Edges.Reserve(Number);
+	if (Number > HashThreshold)
+	{
+		// The map has to contain every edge as soon as it exists, so it is built here instead of on the first Add above the threshold
+		if (!EdgeIndices.IsValid())
+		{
+			BuildEdgeIndices();
+		}
+		EdgeIndices->Reserve(Number);
+	}
+}
+
+void FGraphVertexAdjacency::Shrink()
+{
+	Edges.Shrink();
+	if (Edges.Num() > HashThreshold)
+	{
+		EdgeIndices->Shrink();
+	}
+	else
+	{
+		EdgeIndices.Reset();
+	}
+}
+
+SIZE_T FGraphVertexAdjacency::GetAllocatedSize() const
+{
+	SIZE_T Size = Edges.GetAllocatedSize();
+	if (EdgeIndices.IsValid())
+	{
+		Size += sizeof(*EdgeIndices) + EdgeIndices->GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FGraphVertexAdjacency::AddReferencedObjects(FReferenceCollector& Collector, const UObject* Referencer)
+{
+	for (UGraphStructureEdge*& Edge : Edges)
+	{
+		Collector.AddReferencedObject(Edge, Referencer);
+	}
+}
@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SpanningForest/GraphLinkCutForest.h"
+
+bool FGraphLinkCutForest::IsSplayRoot(const int32 Node) const
+{
+	const int32 Parent = Nodes[Node].Parent;
+	return Parent == INDEX_NONE || (Nodes[Parent].Children[0] != Node && Nodes[Parent].Children[1] != Node);
+}
+
+void FGraphLinkCutForest::UpdateMax(const int32 Node)
+{
+	FNode& NodeData = Nodes[Node];
+	NodeData.MaxNode = Node;
+	for (const int32 Child : NodeData.Children)
+	{
+		if (Child != INDEX_NONE && Nodes[Nodes[Child].MaxNode].Value > Nodes[NodeData.MaxNode].Value)
+		{
+			NodeData.MaxNode = Nodes[Child].MaxNode;
+		}
+	}
+}
+
+void FGraphLinkCutForest::PushFlip(const int32 Node)
+{
+	FNode& NodeData = Nodes[Node];
+	if (NodeData.bFlipped)
+	{
+		Swap(NodeData.Children[0], NodeData.Children[1]);
+		for (const int32 Child : NodeData.Children)
+		{
+			if (Child != INDEX_NONE)
+			{
+				Nodes[Child].bFlipped = !Nodes[Child].bFlipped;
+			}
+		}
+		NodeData.bFlipped = false;
+	}
+}
+
+void FGraphLinkCutForest::Rotate(const int32 Node)
+{
+	const int32 Parent = Nodes[Node].Parent;
+	const int32 GrandParent = Nodes[Parent].Parent;
+	const int32 Side = Nodes[Parent].Children[1] == Node ? 1 : 0;
+
+	if (!IsSplayRoot(Parent))
+	{
+		FNode& GrandParentData = Nodes[GrandParent];
+		GrandParentData.Children[GrandParentData.Children[1] == Parent ? 1 : 0] = Node;
+	}
+	Nodes[Node].Parent = GrandParent;
+
+	const int32 MovedChild = Nodes[Node].Children[1 - Side];
+	Nodes[Parent].Children[Side] = MovedChild;
+	if (MovedChild != INDEX_NONE)
+	{
+		Nodes[MovedChild].Parent = Parent;
+	}
+
+	Nodes[Node].Children[1 - Side] = Parent;
+	Nodes[Parent].Parent = Node;
+
+	UpdateMax(Parent);
+	UpdateMax(Node);
+}
+
+void FGraphLinkCutForest::Splay(const int32 Node)
+{
+	// Push pending flips top-down along the path to the splay root before rotating
+	TArray<int32, TInlineAllocator<64>> Path;
+	Path.Add(Node);
+	for (int32 Current = Node; !IsSplayRoot(Current); Current = Nodes[Current].Parent)
+	{
+		Path.Add(Nodes[Current].Parent);
+	}
+	for (int32 PathIndex = Path.Num() - 1; PathIndex >= 0; --PathIndex)
+	{
+		PushFlip(Path[PathIndex]);
+	}
+
+	while (!IsSplayRoot(Node))
+	{
+		const int32 Parent = Nodes[Node].Parent;
+		if (!IsSplayRoot(Parent))
+		{
+			const int32 GrandParent = Nodes[Parent].Parent;
+			const bool bZigZig = (Nodes[Parent].Children[1] == Node) == (Nodes[GrandParent].Children[1] == Parent);
+			Rotate(bZigZig ? Parent : Node);
+		}
+		Rotate(Node);
+	}
+}
+
+void FGraphLinkCutForest::Access(const int32 Node)
+{
+	int32 Last = INDEX_NONE;
+	for (int32 Current = Node; Current != INDEX_NONE; Current = Nodes[Current].Parent)
+	{
+		Splay(Current);
+		Nodes[Current].Children[1] = Last;
+		UpdateMax(Current);
+		Last = Current;
+	}
+	Splay(Node);
+}
+
+void FGraphLinkCutForest::MakeRoot(const int32 Node)
+{
+	Access(Node);
+	Nodes[Node].bFlipped = !Nodes[Node].bFlipped;
+}
+
+int32 FGraphLinkCutForest::FindRoot(int32 Node)
+{
+	Access(Node);
+	while (true)
+	{
+		PushFlip(Node);
+		const int32 Left = Nodes[Node].Children[0];
+		if (Left == INDEX_NONE)
+		{
+			break;
+		}
+		Node = Left;
+	}
+	// Splay the root to keep the amortized bounds
+	Splay(Node);
+	return Node;
+}
+
+int32 FGraphLinkCutForest::AddNode(const float Value)
+{
+	int32 Node;
+	if (FreeNodes.Num() > 0)
+	{
+		Node = FreeNodes.Pop(EAllowShrinking::No);
+		Nodes[Node] = FNode();
+	}
+	else
+	{
+		Node = Nodes.AddDefaulted();
+	}
+
+	Nodes[Node].Value = Value;
+	Nodes[Node].MaxNode = Node;
+	return Node;
+}
+
+void FGraphLinkCutForest::RemoveNode(const int32 Node)
+{
+	check(Nodes.IsValidIndex(Node));
+	// After accessing an isolated node its splay tree consists of only itself
+	Access(Node);
+	check(Nodes[Node].Children[0] == INDEX_NONE && Nodes[Node].Children[1] == INDEX_NONE);
+
+	FreeNodes.Add(Node);
+}
+
+bool FGraphLinkCutForest::Connected(const int32 A, const int32 B)
+{
+	return A == B || FindRoot(A) == FindRoot(B);
+}
+
+void FGraphLinkCutForest::Link(const int32 A, const int32 B)
+{
+	check(!Connected(A, B));
+	MakeRoot(A);
+	Nodes[A].Parent = B;
+}
+
+void FGraphLinkCutForest::Cut(const int32 A, const int32 B)
+{
+	MakeRoot(A);
+	Access(B);
+
+	// With A as root and B accessed, the path A-B consists of exactly these two nodes if they are linked
+	check(Nodes[B].Children[0] == A);
+	check(Nodes[A].Children[1] == INDEX_NONE);
+
+	Nodes[B].Children[0] = INDEX_NONE;
+	Nodes[A].Parent = INDEX_NONE;
+	UpdateMax(B);
+}
+
+int32 FGraphLinkCutForest::PathMaxNode(const int32 A, const int32 B)
+{
+	check(Connected(A, B));
+	MakeRoot(A);
+	Access(B);
+	return Nodes[B].MaxNode;
+}
+
+void FGraphLinkCutForest::Reset()
+{
+	Nodes.Empty();
+	FreeNodes.Empty();
+}
+
+SIZE_T FGraphLinkCutForest::GetAllocatedSize() const
+{
+	return Nodes.GetAllocatedSize() + FreeNodes.GetAllocatedSize();
+}
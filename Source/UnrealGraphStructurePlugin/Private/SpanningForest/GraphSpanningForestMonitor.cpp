@@ -0,0 +1,438 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SpanningForest/GraphSpanningForestMonitor.h"
+
+#include "Algo/Sort.h"
+
+void UGraphSpanningForestMonitor::InsertEdge(UGraphStructureEdge* Edge)
+{
+	check(Edge != nullptr);
+	check(Edge->Source != nullptr);
+	check(Edge->Target != nullptr);
+
+	const float Weight = Edge->Weight;
+	EdgeWeights.Add(Edge, Weight);
+
+	// Self-loops never are part of a spanning forest
+	if (Edge->Source == Edge->Target)
+	{
+		return;
+	}
+
+	const int32 SourceNode = VertexNodes.FindChecked(Edge->Source);
+	const int32 TargetNode = VertexNodes.FindChecked(Edge->Target);
+
+	if (!LinkCutForest.Connected(SourceNode, TargetNode))
+	{
+		LinkForestEdge(Edge);
+		return;
+	}
+
+	// Adding the edge would close a cycle, keep it only if it is lighter than the heaviest forest edge of that cycle
+	UGraphStructureEdge* HeaviestEdge = NodeEdges[LinkCutForest.PathMaxNode(SourceNode, TargetNode)];
+	check(HeaviestEdge != nullptr);
+	if (EdgeWeights.FindChecked(HeaviestEdge) > Weight)
+	{
+		CutForestEdge(HeaviestEdge);
+		LinkForestEdge(Edge);
+	}
+}
+
+void UGraphSpanningForestMonitor::LinkForestEdge(UGraphStructureEdge* Edge)
+{
+	const float Weight = EdgeWeights.FindChecked(Edge);
+	const int32 EdgeNode = LinkCutForest.AddNode(Weight);
+	if (EdgeNode >= NodeEdges.Num())
+	{
+		NodeEdges.SetNumZeroed(EdgeNode + 1);
+	}
+	NodeEdges[EdgeNode] = Edge;
+
+	LinkCutForest.Link(EdgeNode, VertexNodes.FindChecked(Edge->Source));
+	LinkCutForest.Link(EdgeNode, VertexNodes.FindChecked(Edge->Target));
+
+	ForestEdgeNodes.Add(Edge, EdgeNode);
+	TotalWeight += Weight;
+}
+
+void UGraphSpanningForestMonitor::CutForestEdge(UGraphStructureEdge* Edge)
+{
+	const int32 EdgeNode = ForestEdgeNodes.FindAndRemoveChecked(Edge);
+
+	LinkCutForest.Cut(EdgeNode, VertexNodes.FindChecked(Edge->Source));
+	LinkCutForest.Cut(EdgeNode, VertexNodes.FindChecked(Edge->Target));
+	LinkCutForest.RemoveNode(EdgeNode);
+	NodeEdges[EdgeNode] = nullptr;
+
+	TotalWeight -= EdgeWeights.FindChecked(Edge);
+}
+
+UGraphStructureEdge* UGraphSpanningForestMonitor::FindReplacementEdge(UGraphStructureVertex* Source, UGraphStructureVertex* Target) const
+{
+	// Explore both trees along forest edges in lockstep and stop as soon as the smaller one has been fully discovered,
+	// every non-forest edge leaving it must end in the other tree
+
+	struct FTreeSearch
+	{
+		TSet<UGraphStructureVertex*> Discovered;
+		TArray<UGraphStructureVertex*> Queue;
+		int32 QueueIndex = 0;
+	};
+
+	FTreeSearch Searches[2];
+	Searches[0].Discovered.Add(Source);
+	Searches[0].Queue.Add(Source);
+	Searches[1].Discovered.Add(Target);
+	Searches[1].Queue.Add(Target);
+
+	int32 SmallerTree = INDEX_NONE;
+	while (SmallerTree == INDEX_NONE)
+	{
+		for (int32 SearchIndex = 0; SearchIndex < 2; ++SearchIndex)
+		{
+			FTreeSearch& Search = Searches[SearchIndex];
+			if (Search.QueueIndex == Search.Queue.Num())
+			{
+				SmallerTree = SearchIndex;
+				break;
+			}
+
+			const UGraphStructureVertex* NextVertex = Search.Queue[Search.QueueIndex++];
+			for (UGraphStructureEdge* Edge : NextVertex->Adjacency)
+			{
+				if (!ForestEdgeNodes.Contains(Edge))
+				{
+					continue;
+				}
+
+				UGraphStructureVertex* Neighbour = Edge->Source == NextVertex ? Edge->Target : Edge->Source;
+				if (!Search.Discovered.Contains(Neighbour))
+				{
+					Search.Discovered.Add(Neighbour);
+					Search.Queue.Add(Neighbour);
+				}
+			}
+		}
+	}
+
+	const TSet<UGraphStructureVertex*>& TreeVertices = Searches[SmallerTree].Discovered;
+
+	UGraphStructureEdge* LightestEdge = nullptr;
+	float LightestWeight = TNumericLimits<float>::Max();
+	for (const UGraphStructureVertex* TreeVertex : TreeVertices)
+	{
+		for (UGraphStructureEdge* Edge : TreeVertex->Adjacency)
+		{
+			UGraphStructureVertex* Neighbour = Edge->Source == TreeVertex ? Edge->Target : Edge->Source;
+			if (TreeVertices.Contains(Neighbour))
+			{
+				continue;
+			}
+
+			const float Weight = EdgeWeights.FindChecked(Edge);
+			if (LightestEdge == nullptr || Weight < LightestWeight)
+			{
+				LightestEdge = Edge;
+				LightestWeight = Weight;
+			}
+		}
+	}
+
+	return LightestEdge;
+}
+
+void UGraphSpanningForestMonitor::GraphStructure_VertexAdded(UGraphStructureVertex* Vertex)
+{
+	check(Vertex != nullptr);
+	check(!VertexNodes.Contains(Vertex));
+
+	const int32 VertexNode = LinkCutForest.AddNode(TNumericLimits<float>::Lowest());
+	if (VertexNode >= NodeEdges.Num())
+	{
+		NodeEdges.SetNumZeroed(VertexNode + 1);
+	}
+	NodeEdges[VertexNode] = nullptr;
+
+	VertexNodes.Add(Vertex, VertexNode);
+}
+
+void UGraphSpanningForestMonitor::GraphStructure_VertexRemoved(UGraphStructureVertex* Vertex)
+{
+	check(Vertex != nullptr);
+	// Since the RemoveVertex functions in the graph always remove Edges first the vertex node is isolated already
+	check(Vertex->Adjacency.IsEmpty());
+
+	LinkCutForest.RemoveNode(VertexNodes.FindAndRemoveChecked(Vertex));
+}
+
+void UGraphSpanningForestMonitor::GraphStructure_EdgeAdded(UGraphStructureEdge* Edge)
+{
+	InsertEdge(Edge);
+}
+
+void UGraphSpanningForestMonitor::GraphStructure_EdgeRemoved(UGraphStructureEdge* Edge)
+{
+	check(Edge != nullptr);
+
+	// Edges of a removed vertex were already handled together in GraphStructure_VertexEdgesRemoved
+	if (Graph->IsRemovedWithVertex(Edge))
+	{
+		return;
+	}
+
+	const bool bWasForestEdge = ForestEdgeNodes.Contains(Edge);
+	if (bWasForestEdge)
+	{
+		CutForestEdge(Edge);
+	}
+	EdgeWeights.Remove(Edge);
+
+	if (bWasForestEdge)
+	{
+		// The graph already removed the edge from its vertices, so the search only sees the remaining edges
+		if (UGraphStructureEdge* ReplacementEdge = FindReplacementEdge(Edge->Source, Edge->Target))
+		{
+			LinkForestEdge(ReplacementEdge);
+		}
+	}
+}
+
+void UGraphSpanningForestMonitor::GraphStructure_VertexEdgesRemoved(UGraphStructureVertex* Vertex, const TArray<UGraphStructureEdge*>& Edges)
+{
+	check(Vertex != nullptr);
+	check(Vertex->Adjacency.IsEmpty());
+
+	// Cut all forest edges of the vertex at once, this splits its tree into one piece per former forest neighbour
+	TArray<UGraphStructureVertex*> FormerNeighbours;
+	for (UGraphStructureEdge* Edge : Edges)
+	{
+		check(Edge != nullptr);
+
+		if (ForestEdgeNodes.Contains(Edge))
+		{
+			CutForestEdge(Edge);
+			FormerNeighbours.AddUnique(Edge->Source == Vertex ? Edge->Target : Edge->Source);
+		}
+		EdgeWeights.Remove(Edge);
+	}
+
+	if (FormerNeighbours.Num() < 2)
+	{
+		return;
+	}
+
+	// Explore the pieces along forest edges in lockstep until all but the biggest one have been fully discovered. The removed vertex
+	// has no edges left, so it can't be reached. Non-forest edges only run between pieces, any edge into an undiscovered vertex
+	// therefore ends in the biggest piece
+
+	struct FPieceSearch
+	{
+		TArray<UGraphStructureVertex*> Queue;
+		int32 QueueIndex = 0;
+	};
+
+	TArray<FPieceSearch> Searches;
+	Searches.SetNum(FormerNeighbours.Num());
+	TMap<UGraphStructureVertex*, int32> DiscoveredBy;
+	TArray<int32> OpenSearches;
+	for (int32 Piece = 0; Piece < FormerNeighbours.Num(); ++Piece)
+	{
+		Searches[Piece].Queue.Add(FormerNeighbours[Piece]);
+		DiscoveredBy.Add(FormerNeighbours[Piece], Piece);
+		OpenSearches.Add(Piece);
+	}
+
+	int32 NextOpenSearch = 0;
+	while (OpenSearches.Num() > 1)
+	{
+		if (NextOpenSearch >= OpenSearches.Num())
+		{
+			NextOpenSearch = 0;
+		}
+
+		const int32 Piece = OpenSearches[NextOpenSearch];
+		FPieceSearch& Search = Searches[Piece];
+		if (Search.QueueIndex == Search.Queue.Num())
+		{
+			OpenSearches.RemoveAt(NextOpenSearch);
+			continue;
+		}
+
+		const UGraphStructureVertex* NextVertex = Search.Queue[Search.QueueIndex++];
+		for (UGraphStructureEdge* Edge : NextVertex->Adjacency)
+		{
+			if (!ForestEdgeNodes.Contains(Edge))
+			{
+				continue;
+			}
+
+			UGraphStructureVertex* Neighbour = Edge->Source == NextVertex ? Edge->Target : Edge->Source;
+			if (!DiscoveredBy.Contains(Neighbour))
+			{
+				DiscoveredBy.Add(Neighbour, Piece);
+				Search.Queue.Add(Neighbour);
+			}
+		}
+
+		++NextOpenSearch;
+	}
+	check(OpenSearches.Num() == 1);
+	const int32 BiggestPiece = OpenSearches[0];
+
+	// Edges leaving the fully discovered pieces are the only candidates for reconnecting them
+	struct FCandidate
+	{
+		UGraphStructureEdge* Edge;
+		float Weight;
+		int32 PieceA;
+		int32 PieceB;
+	};
+
+	TArray<FCandidate> Candidates;
+	for (int32 Piece = 0; Piece < Searches.Num(); ++Piece)
+	{
+		if (Piece == BiggestPiece)
+		{
+			continue;
+		}
+
+		for (const UGraphStructureVertex* PieceVertex : Searches[Piece].Queue)
+		{
+			for (UGraphStructureEdge* Edge : PieceVertex->Adjacency)
+			{
+				const UGraphStructureVertex* Neighbour = Edge->Source == PieceVertex ? Edge->Target : Edge->Source;
+				const int32* NeighbourPiece = DiscoveredBy.Find(Neighbour);
+				const int32 OtherPiece = NeighbourPiece != nullptr && *NeighbourPiece != BiggestPiece ? *NeighbourPiece : BiggestPiece;
+				if (OtherPiece != Piece)
+				{
+					Candidates.Add({Edge, EdgeWeights.FindChecked(Edge), Piece, OtherPiece});
+				}
+			}
+		}
+	}
+
+	// Kruskal's algorithm over the pieces, the remaining forest edges stay part of the minimum spanning forest
+	Algo::SortBy(Candidates, &FCandidate::Weight);
+
+	TArray<int32> Parents;
+	Parents.SetNumUninitialized(Searches.Num());
+	for (int32 Piece = 0; Piece < Parents.Num(); ++Piece)
+	{
+		Parents[Piece] = Piece;
+	}
+	auto FindRoot = [&Parents](int32 Piece)
+	{
+		while (Parents[Piece] != Piece)
+		{
+			Parents[Piece] = Parents[Parents[Piece]];
+			Piece = Parents[Piece];
+		}
+		return Piece;
+	};
+
+	for (const FCandidate& Candidate : Candidates)
+	{
+		const int32 RootA = FindRoot(Candidate.PieceA);
+		const int32 RootB = FindRoot(Candidate.PieceB);
+		if (RootA != RootB)
+		{
+			Parents[RootA] = RootB;
+			LinkForestEdge(Candidate.Edge);
+		}
+	}
+}
+
+void UGraphSpanningForestMonitor::GraphStructure_BulkAdded(const TArray<UGraphStructureVertex*>& NewVertices,
+                                                           const TArray<UGraphStructureEdge*>& NewEdges)
+{
+	for (UGraphStructureVertex* Vertex : NewVertices)
+	{
+		GraphStructure_VertexAdded(Vertex);
+	}
+
+	// Like in Setup, inserting by increasing weight keeps replacements to edges that were already in the forest before
+	TArray<UGraphStructureEdge*> SortedEdges = NewEdges;
+	Algo::SortBy(SortedEdges, [](const UGraphStructureEdge* Edge) { return Edge->Weight; });
+	for (UGraphStructureEdge* Edge : SortedEdges)
+	{
+		InsertEdge(Edge);
+	}
+}
+
+void UGraphSpanningForestMonitor::Setup(UGraphStructure* MonitorGraph)
+{
+	if (SetupCompleted)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UGraphSpanningForestMonitor::Setup() called after it already has been setup"));
+		return;
+	}
+
+	check(Graph == nullptr);
+	Graph = MonitorGraph;
+	if (Graph == nullptr)
+	{
+		return;
+	}
+
+	// Bind delegates
+	Graph->OnVertexAdded.AddDynamic(this, &UGraphSpanningForestMonitor::GraphStructure_VertexAdded);
+	Graph->OnVertexRemoved.AddDynamic(this, &UGraphSpanningForestMonitor::GraphStructure_VertexRemoved);
+	Graph->OnEdgeAdded.AddDynamic(this, &UGraphSpanningForestMonitor::GraphStructure_EdgeAdded);
+	Graph->OnEdgeRemoved.AddDynamic(this, &UGraphSpanningForestMonitor::GraphStructure_EdgeRemoved);
+	Graph->OnVertexEdgesRemoved.AddDynamic(this, &UGraphSpanningForestMonitor::GraphStructure_VertexEdgesRemoved);
+	Graph->OnBulkAdded.AddDynamic(this, &UGraphSpanningForestMonitor::GraphStructure_BulkAdded);
+
+	// Setup initial forest
+
+	for (UGraphStructureVertex* Vertex : Graph->GetVertices())
+	{
+		GraphStructure_VertexAdded(Vertex);
+	}
+
+	// Inserting edges by increasing weight never replaces a forest edge, making this equivalent to Kruskal's algorithm
+	TArray<UGraphStructureEdge*> SortedEdges = Graph->GetEdges().Array();
+	Algo::SortBy(SortedEdges, [](const UGraphStructureEdge* Edge) { return Edge->Weight; });
+	for (UGraphStructureEdge* Edge : SortedEdges)
+	{
+		InsertEdge(Edge);
+	}
+
+	// Set SetupCompleted so future setup calls will be ignored and logged
+	SetupCompleted = true;
+}
+
+TSet<UGraphStructureEdge*> UGraphSpanningForestMonitor::GetForestEdges() const
+{
+	TSet<UGraphStructureEdge*> ForestEdges;
+	ForestEdges.Reserve(ForestEdgeNodes.Num());
+	for (const auto& Pair : ForestEdgeNodes)
+	{
+		ForestEdges.Add(Pair.Key);
+	}
+	return ForestEdges;
+}
+
+bool UGraphSpanningForestMonitor::IsForestEdge(UGraphStructureEdge* Edge) const
+{
+	return ForestEdgeNodes.Contains(Edge);
+}
+
+float UGraphSpanningForestMonitor::GetTotalWeight() const
+{
+	return static_cast<float>(TotalWeight);
+}
+
+SIZE_T UGraphSpanningForestMonitor::GetAllocatedSize() const
+{
+	SIZE_T Size = LinkCutForest.GetAllocatedSize() + NodeEdges.GetAllocatedSize();
+	Size += VertexNodes.GetAllocatedSize() + ForestEdgeNodes.GetAllocatedSize() + EdgeWeights.GetAllocatedSize();
+	return Size;
+}
+
+void UGraphSpanningForestMonitor::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetAllocatedSize());
+}
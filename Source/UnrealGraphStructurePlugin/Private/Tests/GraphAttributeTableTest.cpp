@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GraphStructure.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphAttributeTableSerializeTest, "GraphStructure.Attributes.Serialize",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphAttributeTableSerializeTest::RunTest(const FString& Parameters)
+{
+	FGraphAttributeTable Table;
+	Table.AddColumn("Load", EGraphAttributeType::Float);
+	Table.AddColumn("Owner", EGraphAttributeType::Int);
+	Table.AddColumn("Position", EGraphAttributeType::Vector);
+	Table.AddColumn("Powered", EGraphAttributeType::Bool);
+	Table.AddRows(3);
+
+	Table.GetColumn<float>("Load")[1] = 2.5f;
+	Table.GetColumn<int32>("Owner")[2] = 7;
+	Table.GetColumn<FVector>("Position")[0] = FVector(1.0, 2.0, 3.0);
+	(*Table.GetBoolColumn("Powered"))[2] = true;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Writer << Table;
+
+	FGraphAttributeTable LoadedTable;
+	FMemoryReader Reader(Bytes);
+	Reader << LoadedTable;
+
+	TestEqual(TEXT("Rows"), LoadedTable.Num(), 3);
+	TestEqual(TEXT("Float value"), LoadedTable.GetColumn<float>("Load")[1], 2.5f);
+	TestEqual(TEXT("Int value"), LoadedTable.GetColumn<int32>("Owner")[2], 7);
+	TestEqual(TEXT("Vector value"), LoadedTable.GetColumn<FVector>("Position")[0], FVector(1.0, 2.0, 3.0));
+	TestEqual(TEXT("Set bits"), LoadedTable.CountTrue("Powered"), 1);
+	TestTrue(TEXT("Bool value"), (*LoadedTable.GetBoolColumn("Powered"))[2]);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphAttributeTableDuplicateTest, "GraphStructure.Attributes.Duplicate",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphAttributeTableDuplicateTest::RunTest(const FString& Parameters)
+{
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	UGraphStructureVertex* A = Graph->AddDefaultVertex();
+	UGraphStructureVertex* B = Graph->AddDefaultVertex();
+	UGraphStructureEdge* Edge = Graph->AddDefaultEdgeBetween(A, B);
+
+	Graph->AddVertexAttribute("Supply", EGraphAttributeType::Float);
+	Graph->AddEdgeAttribute("Open", EGraphAttributeType::Bool);
+	Graph->SetVertexFloatAttribute(B, "Supply", 4.0f);
+	Graph->SetEdgeBoolAttribute(Edge, "Open", true);
+
+	// Default elements are created inside the graph, so they are duplicated along with it
+	UGraphStructure* Copy = DuplicateObject<UGraphStructure>(Graph, GetTransientPackage());
+	TestEqual(TEXT("Vertices"), Copy->GetNumVertices(), 2);
+	TestEqual(TEXT("Edges"), Copy->GetNumEdges(), 1);
+	TestNotEqual(TEXT("Vertex is a copy"), Copy->GetVertexById(B->GraphId), B);
+
+	float Supply = 0.0f;
+	TestTrue(TEXT("Vertex attribute found"), Copy->GetVertexFloatAttribute(Copy->GetVertexById(B->GraphId), "Supply", Supply));
+	TestEqual(TEXT("Vertex attribute"), Supply, 4.0f);
+
+	bool bOpen = false;
+	TestTrue(TEXT("Edge attribute found"), Copy->GetEdgeBoolAttribute(Copy->GetEdgeById(Edge->GraphId), "Open", bOpen));
+	TestTrue(TEXT("Edge attribute"), bOpen);
+
+	return true;
+}
+
+#endif
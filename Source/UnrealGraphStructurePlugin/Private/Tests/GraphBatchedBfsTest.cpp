@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GraphStructure.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Sparse random graph, with few edges per vertex it falls apart into several components of varying size
+	UGraphStructure* CreateRandomGraph(const int32 NumVertices, const int32 NumEdges, const int32 Seed)
+	{
+		UGraphStructure* Graph = NewObject<UGraphStructure>();
+		Graph->AddVerticesBulk(NumVertices);
+
+		FRandomStream RandomStream(Seed);
+		TArray<FIntPoint> EdgeEndpoints;
+		EdgeEndpoints.Reserve(NumEdges);
+		for (int32 EdgeIndex = 0; EdgeIndex < NumEdges; ++EdgeIndex)
+		{
+			EdgeEndpoints.Add({RandomStream.RandRange(0, NumVertices - 1), RandomStream.RandRange(0, NumVertices - 1)});
+		}
+		Graph->AddEdgesBulk(EdgeEndpoints);
+		return Graph;
+	}
+
+	TArray<UGraphStructureVertex*> PickRandomVertices(UGraphStructure* Graph, const int32 Count, FRandomStream& RandomStream)
+	{
+		TArray<UGraphStructureVertex*> Picked;
+		Picked.Reserve(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Picked.Add(Graph->GetVertexById(RandomStream.RandRange(0, Graph->GetNumVertices() - 1)));
+		}
+		return Picked;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphBatchedConnectedVerticesTest, "GraphStructure.Query.Batched.FindAllConnectedVertices",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphBatchedConnectedVerticesTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumQueries = 300;
+	UGraphStructure* Graph = CreateRandomGraph(20000, 11000, 7);
+	FRandomStream RandomStream(11);
+	const TArray<UGraphStructureVertex*> RootVertices = PickRandomVertices(Graph, NumQueries, RandomStream);
+
+	const double BatchedStartTime = FPlatformTime::Seconds();
+	const TArray<FGraphVertexSet> BatchedResults = Graph->BatchedFindAllConnectedVertices(RootVertices);
+	const double BatchedTime = FPlatformTime::Seconds() - BatchedStartTime;
+
+	TArray<TSet<UGraphStructureVertex*>> SingleResults;
+	const double SingleStartTime = FPlatformTime::Seconds();
+	for (UGraphStructureVertex* RootVertex : RootVertices)
+	{
+		SingleResults.Add(Graph->FindAllConnectedVertices(RootVertex));
+	}
+	const double SingleTime = FPlatformTime::Seconds() - SingleStartTime;
+
+	if (!TestEqual(TEXT("Number of results"), BatchedResults.Num(), NumQueries))
+	{
+		return false;
+	}
+	for (int32 Query = 0; Query < NumQueries; ++Query)
+	{
+		const TSet<UGraphStructureVertex*>& Batched = BatchedResults[Query].Vertices;
+		const TSet<UGraphStructureVertex*>& Single = SingleResults[Query];
+		TestTrue(FString::Printf(TEXT("Query %d finds the same vertices"), Query),
+		         Batched.Num() == Single.Num() && Batched.Includes(Single));
+	}
+
+	AddInfo(FString::Printf(TEXT("%d queries: batched %.2f ms, single-source loop %.2f ms"), NumQueries, BatchedTime * 1000.0,
+	                        SingleTime * 1000.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphBatchedShortestPathsTest, "GraphStructure.Query.Batched.BfsShortestPaths",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphBatchedShortestPathsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumQueries = 300;
+	UGraphStructure* Graph = CreateRandomGraph(20000, 24000, 13);
+	FRandomStream RandomStream(17);
+	TArray<UGraphStructureVertex*> SourceVertices = PickRandomVertices(Graph, NumQueries, RandomStream);
+	TArray<UGraphStructureVertex*> TargetVertices = PickRandomVertices(Graph, NumQueries, RandomStream);
+	// Include a query whose source is its target
+	TargetVertices[0] = SourceVertices[0];
+
+	const double BatchedStartTime = FPlatformTime::Seconds();
+	const TArray<FGraphVertexPath> BatchedResults = Graph->BatchedBfsShortestPaths(SourceVertices, TargetVertices);
+	const double BatchedTime = FPlatformTime::Seconds() - BatchedStartTime;
+
+	TArray<TArray<UGraphStructureVertex*>> SingleResults;
+	SingleResults.SetNum(NumQueries);
+	TArray<bool> SingleFound;
+	const double SingleStartTime = FPlatformTime::Seconds();
+	for (int32 Query = 0; Query < NumQueries; ++Query)
+	{
+		SingleFound.Add(Graph->BfsShortestPath(SourceVertices[Query], TargetVertices[Query], SingleResults[Query]));
+	}
+	const double SingleTime = FPlatformTime::Seconds() - SingleStartTime;
+
+	if (!TestEqual(TEXT("Number of results"), BatchedResults.Num(), NumQueries))
+	{
+		return false;
+	}
+	for (int32 Query = 0; Query < NumQueries; ++Query)
+	{
+		const TArray<UGraphStructureVertex*>& Batched = BatchedResults[Query].Vertices;
+		const TArray<UGraphStructureVertex*>& Single = SingleResults[Query];
+
+		// Ties may be broken differently, so only the distances have to match as long as the batched path is valid
+		TestEqual(FString::Printf(TEXT("Query %d finds a path"), Query), !Batched.IsEmpty(), SingleFound[Query]);
+		TestEqual(FString::Printf(TEXT("Query %d distance"), Query), Batched.Num(), Single.Num());
+		if (Batched.IsEmpty())
+		{
+			continue;
+		}
+
+		TestTrue(FString::Printf(TEXT("Query %d path endpoints"), Query),
+		         Batched[0] == SourceVertices[Query] && Batched.Last() == TargetVertices[Query]);
+		for (int32 Step = 1; Step < Batched.Num(); ++Step)
+		{
+			if (!Graph->HasEdgeBetween(Batched[Step - 1], Batched[Step]))
+			{
+				AddError(FString::Printf(TEXT("Query %d path has no edge at step %d"), Query, Step));
+				break;
+			}
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("%d queries: batched %.2f ms, single-source loop %.2f ms"), NumQueries, BatchedTime * 1000.0,
+	                        SingleTime * 1000.0));
+	return true;
+}
+
+#endif
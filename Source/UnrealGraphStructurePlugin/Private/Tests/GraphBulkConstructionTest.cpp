@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GraphStructure.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphBulkConstructionTimingTest, "GraphStructure.Construction.Bulk.OneMillionEdges",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphBulkConstructionTimingTest::RunTest(const FString& Parameters)
+{
+	// Every vertex connects to the next 4 vertices of a ring, giving 1M edges and degree 8 everywhere
+	constexpr int32 NumVertices = 250000;
+	constexpr int32 EdgesPerVertex = 4;
+	constexpr double TargetSeconds = 1.0;
+
+	TArray<FIntPoint> EdgeEndpoints;
+	EdgeEndpoints.Reserve(NumVertices * EdgesPerVertex);
+	for (int32 Id = 0; Id < NumVertices; ++Id)
+	{
+		for (int32 Offset = 1; Offset <= EdgesPerVertex; ++Offset)
+		{
+			EdgeEndpoints.Add({Id, (Id + Offset) % NumVertices});
+		}
+	}
+
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+
+	const double StartTime = FPlatformTime::Seconds();
+	Graph->AddVerticesBulk(NumVertices);
+	const double VerticesTime = FPlatformTime::Seconds() - StartTime;
+
+	const double EdgesStartTime = FPlatformTime::Seconds();
+	Graph->AddEdgesBulk(EdgeEndpoints);
+	const double EdgesTime = FPlatformTime::Seconds() - EdgesStartTime;
+
+	TestEqual(TEXT("Vertices"), Graph->GetNumVertices(), NumVertices);
+	TestEqual(TEXT("Edges"), Graph->GetNumEdges(), NumVertices * EdgesPerVertex);
+	TestEqual(TEXT("Degree of first vertex"), Graph->GetVertexById(0)->Adjacency.Num(), 2 * EdgesPerVertex);
+	TestEqual(TEXT("Degree of last vertex"), Graph->GetVertexById(NumVertices - 1)->Adjacency.Num(), 2 * EdgesPerVertex);
+	TestTrue(TEXT("Wrapping edge exists"), Graph->HasEdgeBetween(Graph->GetVertexById(NumVertices - 1), Graph->GetVertexById(0)));
+
+	// Timings depend on the machine, exceeding the target is reported but doesn't fail the test
+	const double TotalTime = VerticesTime + EdgesTime;
+	AddInfo(FString::Printf(TEXT("%d vertices: %.1f ms, %d edges: %.1f ms, total %.1f ms"), NumVertices, VerticesTime * 1000.0,
+	                        EdgeEndpoints.Num(), EdgesTime * 1000.0, TotalTime * 1000.0));
+	if (TotalTime > TargetSeconds)
+	{
+		AddWarning(FString::Printf(TEXT("Bulk construction took %.2f s, target is below %.2f s"), TotalTime, TargetSeconds));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphBulkConstructionAdjacencyListTest, "GraphStructure.Construction.Bulk.FromAdjacencyList",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphBulkConstructionAdjacencyListTest::RunTest(const FString& Parameters)
+{
+	// Triangle 0-1-2 plus a self-loop on 3, symmetric entries only create one edge
+	const TArray<TArray<int32>> AdjacencyList = {{1, 2}, {0, 2}, {0, 1}, {3}};
+	UGraphStructure* Graph = UGraphStructure::FromAdjacencyList(AdjacencyList);
+	if (!TestNotNull(TEXT("Graph"), Graph))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Vertices"), Graph->GetNumVertices(), 4);
+	TestEqual(TEXT("Edges"), Graph->GetNumEdges(), 4);
+	TestEqual(TEXT("Triangle degree"), Graph->GetVertexById(1)->Adjacency.Num(), 2);
+	TestEqual(TEXT("Self-loop listed once"), Graph->GetVertexById(3)->Adjacency.Num(), 1);
+
+	return true;
+}
+
+#endif
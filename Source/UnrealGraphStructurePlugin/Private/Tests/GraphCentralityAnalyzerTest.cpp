@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Analytics/GraphCentralityAnalyzer.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "GraphTestListeners.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Completion is posted to the game thread, so it has to be pumped while waiting. Returns false on timeout
+	bool WaitForEstimation(const UGraphCentralityAnalyzer* Analyzer, const double TimeoutSeconds)
+	{
+		const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+		while (Analyzer->IsRunning())
+		{
+			if (FPlatformTime::Seconds() > Deadline)
+			{
+				return false;
+			}
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FPlatformProcess::Sleep(0.001f);
+		}
+		return true;
+	}
+
+	UGraphStructure* CreatePathGraph(const int32 NumVertices)
+	{
+		UGraphStructure* Graph = NewObject<UGraphStructure>();
+		Graph->AddVerticesBulk(NumVertices);
+
+		TArray<FIntPoint> EdgeEndpoints;
+		for (int32 Id = 0; Id + 1 < NumVertices; ++Id)
+		{
+			EdgeEndpoints.Add({Id, Id + 1});
+		}
+		Graph->AddEdgesBulk(EdgeEndpoints);
+		return Graph;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphCentralityAnalyzerExactPathTest, "GraphStructure.Analytics.Centrality.ExactPath",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphCentralityAnalyzerExactPathTest::RunTest(const FString& Parameters)
+{
+	// ln(5) / 0.05^2 exceeds the vertex count, so every vertex is a source and the scores are exact
+	constexpr int32 NumVertices = 5;
+	UGraphStructure* Graph = CreatePathGraph(NumVertices);
+
+	UGraphCentralityAnalyzer* Analyzer = NewObject<UGraphCentralityAnalyzer>();
+	UGraphCentralityTestListener* Listener = NewObject<UGraphCentralityTestListener>();
+	Analyzer->OnCompleted.AddDynamic(Listener, &UGraphCentralityTestListener::HandleCompleted);
+
+	TestTrue(TEXT("Estimation started"), Analyzer->EstimateCentrality(Graph, "Betweenness", "Closeness", 0.05f));
+	if (!TestTrue(TEXT("Estimation completed"), WaitForEstimation(Analyzer, 10.0)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Completions"), Listener->NumCompletions, 1);
+	TestEqual(TEXT("Sampled sources"), Listener->LastNumSampledSources, NumVertices);
+
+	// Pairs whose shortest path passes through each vertex of 0-1-2-3-4
+	const float ExpectedBetweenness[NumVertices] = {0.0f, 3.0f, 4.0f, 3.0f, 0.0f};
+	// Sum of inverse distances to all other vertices divided by n - 1
+	const float ExpectedCloseness[NumVertices] = {
+		(1.0f + 1.0f / 2 + 1.0f / 3 + 1.0f / 4) / 4, (1.0f + 1.0f + 1.0f / 2 + 1.0f / 3) / 4, (1.0f + 1.0f + 1.0f / 2 + 1.0f / 2) / 4,
+		(1.0f + 1.0f + 1.0f / 2 + 1.0f / 3) / 4, (1.0f + 1.0f / 2 + 1.0f / 3 + 1.0f / 4) / 4
+	};
+	for (int32 Id = 0; Id < NumVertices; ++Id)
+	{
+		float Betweenness = -1.0f;
+		float Closeness = -1.0f;
+		TestTrue(TEXT("Betweenness written"), Graph->GetVertexFloatAttribute(Graph->GetVertexById(Id), "Betweenness", Betweenness));
+		TestTrue(TEXT("Closeness written"), Graph->GetVertexFloatAttribute(Graph->GetVertexById(Id), "Closeness", Closeness));
+		TestEqual(FString::Printf(TEXT("Betweenness of %d"), Id), Betweenness, ExpectedBetweenness[Id], KINDA_SMALL_NUMBER);
+		TestEqual(FString::Printf(TEXT("Closeness of %d"), Id), Closeness, ExpectedCloseness[Id], KINDA_SMALL_NUMBER);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphCentralityAnalyzerExactStarTest, "GraphStructure.Analytics.Centrality.ExactStar",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphCentralityAnalyzerExactStarTest::RunTest(const FString& Parameters)
+{
+	// Center 0 with 5 leaves, every pair of leaves is connected through the center only
+	constexpr int32 NumLeaves = 5;
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	Graph->AddVerticesBulk(NumLeaves + 1);
+	TArray<FIntPoint> EdgeEndpoints;
+	for (int32 Leaf = 1; Leaf <= NumLeaves; ++Leaf)
+	{
+		EdgeEndpoints.Add({0, Leaf});
+	}
+	Graph->AddEdgesBulk(EdgeEndpoints);
+
+	UGraphCentralityAnalyzer* Analyzer = NewObject<UGraphCentralityAnalyzer>();
+	TestTrue(TEXT("Estimation started"), Analyzer->EstimateCentrality(Graph, "Betweenness", "Closeness", 0.05f));
+	if (!TestTrue(TEXT("Estimation completed"), WaitForEstimation(Analyzer, 10.0)))
+	{
+		return false;
+	}
+
+	float Betweenness = -1.0f;
+	float Closeness = -1.0f;
+	Graph->GetVertexFloatAttribute(Graph->GetVertexById(0), "Betweenness", Betweenness);
+	Graph->GetVertexFloatAttribute(Graph->GetVertexById(0), "Closeness", Closeness);
+	TestEqual(TEXT("Center betweenness"), Betweenness, static_cast<float>(NumLeaves * (NumLeaves - 1) / 2), KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Center closeness"), Closeness, 1.0f, KINDA_SMALL_NUMBER);
+
+	Graph->GetVertexFloatAttribute(Graph->GetVertexById(1), "Betweenness", Betweenness);
+	Graph->GetVertexFloatAttribute(Graph->GetVertexById(1), "Closeness", Closeness);
+	TestEqual(TEXT("Leaf betweenness"), Betweenness, 0.0f, KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Leaf closeness"), Closeness, (1.0f + (NumLeaves - 1) * 0.5f) / NumLeaves, KINDA_SMALL_NUMBER);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphCentralityAnalyzerCancelTest, "GraphStructure.Analytics.Centrality.Cancel",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphCentralityAnalyzerCancelTest::RunTest(const FString& Parameters)
+{
+	UGraphStructure* Graph = CreatePathGraph(5000);
+
+	UGraphCentralityAnalyzer* Analyzer = NewObject<UGraphCentralityAnalyzer>();
+	UGraphCentralityTestListener* Listener = NewObject<UGraphCentralityTestListener>();
+	Analyzer->OnCompleted.AddDynamic(Listener, &UGraphCentralityTestListener::HandleCompleted);
+
+	TestTrue(TEXT("Estimation started"), Analyzer->EstimateCentrality(Graph, "Betweenness", NAME_None, 0.05f));
+	Analyzer->Cancel();
+	TestFalse(TEXT("Not running after cancel"), Analyzer->IsRunning());
+
+	// Even if the background task already finished, its completion must not be delivered anymore
+	const double Deadline = FPlatformTime::Seconds() + 0.5;
+	while (FPlatformTime::Seconds() < Deadline)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	TestEqual(TEXT("No completion"), Listener->NumCompletions, 0);
+	TestEqual(TEXT("No scores written"), Graph->SumVertexFloatAttribute("Betweenness"), 0.0);
+
+	// The analyzer can be used again after cancelling
+	TestTrue(TEXT("Restarted"), Analyzer->EstimateCentrality(CreatePathGraph(5), "Betweenness", NAME_None, 0.05f));
+	TestTrue(TEXT("Restarted estimation completed"), WaitForEstimation(Analyzer, 10.0));
+	TestEqual(TEXT("One completion"), Listener->NumCompletions, 1);
+
+	return true;
+}
+
+#endif
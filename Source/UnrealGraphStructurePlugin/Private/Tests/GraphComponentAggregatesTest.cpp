@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ConnectedComponents/GraphConnectedComponentsMonitor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const FName TestChannel = "Supply";
+
+	// Aggregate of the component computed from scratch, to compare against the incrementally maintained one
+	FGraphComponentAggregate ComputeAggregate(UGraphConnectedComponentsMonitor* Monitor, UGraphConnectedComponent* ConnectedComponent)
+	{
+		FGraphComponentAggregate Aggregate;
+		for (UGraphStructureVertex* Vertex : ConnectedComponent->GetVertices())
+		{
+			float Value;
+			if (Monitor->GetVertexValue(TestChannel, Vertex, Value))
+			{
+				Aggregate.Add(Value);
+			}
+		}
+		return Aggregate;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphComponentAggregatesSplitTest, "GraphStructure.ConnectedComponents.Aggregates.Split",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphComponentAggregatesSplitTest::RunTest(const FString& Parameters)
+{
+	// Path 0-1-...-9 where every vertex holds its id as value
+	constexpr int32 NumVertices = 10;
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	TArray<UGraphStructureVertex*> Path = Graph->AddVerticesBulk(NumVertices);
+	TArray<UGraphStructureEdge*> PathEdges;
+	for (int32 i = 0; i + 1 < NumVertices; ++i)
+	{
+		PathEdges.Add(Graph->AddDefaultEdgeBetween(Path[i], Path[i + 1]));
+	}
+
+	UGraphConnectedComponentsMonitor* Monitor = NewObject<UGraphConnectedComponentsMonitor>();
+	Monitor->Setup(Graph, UGraphConnectedComponent::StaticClass());
+	Monitor->AddAggregateChannel(TestChannel);
+	for (int32 i = 0; i < NumVertices; ++i)
+	{
+		Monitor->SetVertexValue(TestChannel, Path[i], static_cast<float>(i));
+	}
+
+	// Splitting off the upper half takes the maximum with it
+	Graph->RemoveEdge(PathEdges[4]);
+	const FGraphComponentAggregate Lower = Monitor->GetConnectedComponentOfVertex(Path[0])->GetAggregate(TestChannel);
+	TestEqual(TEXT("Lower count"), Lower.Count, 5);
+	TestEqual(TEXT("Lower sum"), Lower.Sum, 10.0);
+	TestEqual(TEXT("Lower min"), Lower.Min, 0.0f);
+	TestEqual(TEXT("Lower max"), Lower.Max, 4.0f);
+
+	const FGraphComponentAggregate Upper = Monitor->GetConnectedComponentOfVertex(Path[9])->GetAggregate(TestChannel);
+	TestEqual(TEXT("Upper min"), Upper.Min, 5.0f);
+	TestEqual(TEXT("Upper max"), Upper.Max, 9.0f);
+
+	// Replacing the only maximum and clearing the only minimum recover the extrema from the remaining values
+	Monitor->SetVertexValue(TestChannel, Path[4], 1.0f);
+	Monitor->ClearVertexValue(TestChannel, Path[0]);
+	const FGraphComponentAggregate Changed = Monitor->GetConnectedComponentOfVertex(Path[0])->GetAggregate(TestChannel);
+	TestEqual(TEXT("Changed count"), Changed.Count, 4);
+	TestEqual(TEXT("Changed min"), Changed.Min, 1.0f);
+	TestEqual(TEXT("Changed min count"), Changed.MinCount, 2);
+	TestEqual(TEXT("Changed max"), Changed.Max, 3.0f);
+
+	// Merging back combines both sides
+	PathEdges[4] = Graph->AddDefaultEdgeBetween(Path[4], Path[5]);
+	const FGraphComponentAggregate Merged = Monitor->GetConnectedComponentOfVertex(Path[0])->GetAggregate(TestChannel);
+	TestEqual(TEXT("Merged count"), Merged.Count, 9);
+	TestEqual(TEXT("Merged min"), Merged.Min, 1.0f);
+	TestEqual(TEXT("Merged max"), Merged.Max, 9.0f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphComponentAggregatesRandomTest, "GraphStructure.ConnectedComponents.Aggregates.Random",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphComponentAggregatesRandomTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumVertices = 200;
+	constexpr int32 NumSteps = 5000;
+	FRandomStream RandomStream(7);
+
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	TArray<UGraphStructureVertex*> Vertices = Graph->AddVerticesBulk(NumVertices);
+
+	UGraphConnectedComponentsMonitor* Monitor = NewObject<UGraphConnectedComponentsMonitor>();
+	Monitor->Setup(Graph, UGraphConnectedComponent::StaticClass());
+	Monitor->AddAggregateChannel(TestChannel);
+
+	// Few distinct values so extrema are often shared and have to be counted
+	auto RandomVertex = [&]() { return Vertices[RandomStream.RandRange(0, NumVertices - 1)]; };
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		const int32 Operation = RandomStream.RandRange(0, 9);
+		if (Operation < 4)
+		{
+			Graph->AddDefaultEdgeBetween(RandomVertex(), RandomVertex());
+		}
+		else if (Operation < 7 && Graph->GetNumEdges() > 0)
+		{
+			Graph->RemoveEdge(Graph->GetEdgeById(RandomStream.RandRange(0, Graph->GetNumEdges() - 1)));
+		}
+		else if (Operation < 9)
+		{
+			Monitor->SetVertexValue(TestChannel, RandomVertex(), static_cast<float>(RandomStream.RandRange(0, 20)));
+		}
+		else
+		{
+			Monitor->ClearVertexValue(TestChannel, RandomVertex());
+		}
+	}
+
+	for (UGraphConnectedComponent* ConnectedComponent : Monitor->GetAllUsedConnectedComponents())
+	{
+		const FGraphComponentAggregate Expected = ComputeAggregate(Monitor, ConnectedComponent);
+		const FGraphComponentAggregate Actual = ConnectedComponent->GetAggregate(TestChannel);
+		TestEqual(TEXT("Count"), Actual.Count, Expected.Count);
+		TestEqual(TEXT("Sum"), Actual.Sum, Expected.Sum);
+		if (Expected.Count > 0)
+		{
+			TestEqual(TEXT("Min"), Actual.Min, Expected.Min);
+			TestEqual(TEXT("Max"), Actual.Max, Expected.Max);
+			TestEqual(TEXT("Min count"), Actual.MinCount, Expected.MinCount);
+			TestEqual(TEXT("Max count"), Actual.MaxCount, Expected.MaxCount);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,195 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ConnectedComponents/GraphConnectedComponentsMonitor.h"
+#include "GraphTestListeners.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Monitor recording the events of every component, coalescing starts after the components of the initial graph were announced
+	UGraphConnectedComponentsMonitor* CreateCoalescingMonitor(UGraphStructure* Graph)
+	{
+		UGraphConnectedComponentsMonitor* Monitor = NewObject<UGraphConnectedComponentsMonitor>();
+		Monitor->Setup(Graph, UGraphRecordingConnectedComponent::StaticClass());
+		Monitor->SetCoalesceEvents(true);
+		for (UGraphConnectedComponent* ConnectedComponent : Monitor->GetAllUsedConnectedComponents())
+		{
+			CastChecked<UGraphRecordingConnectedComponent>(ConnectedComponent)->ResetRecording();
+		}
+		return Monitor;
+	}
+
+	UGraphRecordingConnectedComponent* GetRecordingComponent(UGraphConnectedComponentsMonitor* Monitor, UGraphStructureVertex* Vertex)
+	{
+		return CastChecked<UGraphRecordingConnectedComponent>(Monitor->GetConnectedComponentOfVertex(Vertex));
+	}
+
+	// Path 0-1-2-3, the edge 1-2 is the only connection between both halves
+	UGraphStructure* CreateBridgedGraph(TArray<UGraphStructureVertex*>& Vertices, UGraphStructureEdge*& Bridge)
+	{
+		UGraphStructure* Graph = NewObject<UGraphStructure>();
+		Vertices = Graph->AddVerticesBulk(4);
+		Graph->AddDefaultEdgeBetween(Vertices[0], Vertices[1]);
+		Bridge = Graph->AddDefaultEdgeBetween(Vertices[1], Vertices[2]);
+		Graph->AddDefaultEdgeBetween(Vertices[2], Vertices[3]);
+		return Graph;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphComponentCoalescingTransientTest, "GraphStructure.ConnectedComponents.Coalescing.Transient",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphComponentCoalescingTransientTest::RunTest(const FString& Parameters)
+{
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	UGraphStructureVertex* A = Graph->AddDefaultVertex();
+	UGraphStructureVertex* B = Graph->AddDefaultVertex();
+	Graph->AddDefaultEdgeBetween(A, B);
+
+	UGraphConnectedComponentsMonitor* Monitor = CreateCoalescingMonitor(Graph);
+	UGraphRecordingConnectedComponent* Existing = GetRecordingComponent(Monitor, A);
+
+	// A vertex added and removed again within the frame, its component is created and destroyed again
+	UGraphStructureVertex* Lonely = Graph->AddDefaultVertex();
+	UGraphRecordingConnectedComponent* LonelyComponent = GetRecordingComponent(Monitor, Lonely);
+	Graph->RemoveVertex(Lonely);
+
+	// A vertex joining the existing component within the frame, its own component is merged away before anyone saw it
+	UGraphStructureVertex* Joining = Graph->AddDefaultVertex();
+	UGraphRecordingConnectedComponent* JoiningComponent = GetRecordingComponent(Monitor, Joining);
+	Graph->AddDefaultEdgeBetween(A, Joining);
+
+	// A vertex joining the existing component and leaving it again within the frame
+	UGraphStructureVertex* Passing = Graph->AddDefaultVertex();
+	UGraphRecordingConnectedComponent* PassingComponent = GetRecordingComponent(Monitor, Passing);
+	Graph->AddDefaultEdgeBetween(B, Passing);
+	Graph->RemoveVertex(Passing);
+
+	TestEqual(TEXT("Nothing delivered before the flush"), Existing->NumEvents(), 0);
+	Monitor->FlushComponentEvents();
+
+	TestEqual(TEXT("No events for the removed vertex's component"), LonelyComponent->NumEvents(), 0);
+	TestEqual(TEXT("No events for the merged component"), JoiningComponent->NumEvents(), 0);
+	TestEqual(TEXT("No events for the passing vertex's component"), PassingComponent->NumEvents(), 0);
+
+	TestEqual(TEXT("No per vertex events while coalescing"), Existing->NumVertexEvents, 0);
+	if (!TestEqual(TEXT("One diff for the existing component"), Existing->Diffs.Num(), 1))
+	{
+		return false;
+	}
+	const FGraphConnectedComponentDiff& Diff = Existing->Diffs[0];
+	TestTrue(TEXT("Only the joining vertex was added"), Diff.AddedVertices == TArray<UGraphStructureVertex*>{Joining});
+	TestTrue(TEXT("Nothing removed"), Diff.RemovedVertices.IsEmpty());
+	TestTrue(TEXT("Transient components filtered from merges"), Diff.MergedFrom.IsEmpty());
+	TestTrue(TEXT("Nothing split"), Diff.SplitInto.IsEmpty());
+
+	// Nothing left to deliver afterwards
+	Existing->ResetRecording();
+	Monitor->FlushComponentEvents();
+	TestEqual(TEXT("Second flush is empty"), Existing->NumEvents(), 0);
+
+	Monitor->SetCoalesceEvents(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphComponentCoalescingMergeSplitTest, "GraphStructure.ConnectedComponents.Coalescing.MergeSplit",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphComponentCoalescingMergeSplitTest::RunTest(const FString& Parameters)
+{
+	TArray<UGraphStructureVertex*> Vertices;
+	UGraphStructureEdge* Bridge;
+	UGraphStructure* Graph = CreateBridgedGraph(Vertices, Bridge);
+	Graph->RemoveEdge(Bridge);
+
+	UGraphConnectedComponentsMonitor* Monitor = CreateCoalescingMonitor(Graph);
+	UGraphRecordingConnectedComponent* Left = GetRecordingComponent(Monitor, Vertices[0]);
+	UGraphRecordingConnectedComponent* Right = GetRecordingComponent(Monitor, Vertices[3]);
+
+	// Merging two announced components lists the absorbed one in the diff of the kept one
+	Bridge = Graph->AddDefaultEdgeBetween(Vertices[1], Vertices[2]);
+	Monitor->FlushComponentEvents();
+
+	UGraphRecordingConnectedComponent* Kept = GetRecordingComponent(Monitor, Vertices[0]);
+	UGraphRecordingConnectedComponent* Absorbed = Kept == Left ? Right : Left;
+	if (!TestEqual(TEXT("One diff for the kept component"), Kept->Diffs.Num(), 1))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Merged from the absorbed component"), Kept->Diffs[0].MergedFrom == TArray<UGraphConnectedComponent*>{Absorbed});
+	TestEqual(TEXT("Vertices of the absorbed component added"), Kept->Diffs[0].AddedVertices.Num(), 2);
+	TestEqual(TEXT("Kept component not destroyed"), Kept->NumDestroyed, 0);
+	TestEqual(TEXT("Absorbed component destroyed"), Absorbed->NumDestroyed, 1);
+	TestEqual(TEXT("No per vertex events while coalescing"), Kept->NumVertexEvents + Absorbed->NumVertexEvents, 0);
+
+	// Splitting lists the new component in the diff of the old one and announces the new one
+	Kept->ResetRecording();
+	Graph->RemoveEdge(Bridge);
+	Monitor->FlushComponentEvents();
+
+	UGraphRecordingConnectedComponent* Split = GetRecordingComponent(Monitor, Vertices[0]);
+	if (Split == Kept)
+	{
+		Split = GetRecordingComponent(Monitor, Vertices[3]);
+	}
+	TestTrue(TEXT("Halves in different components"), Split != Kept);
+	if (!TestEqual(TEXT("One diff for the split component"), Kept->Diffs.Num(), 1))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Split into the new component"), Kept->Diffs[0].SplitInto == TArray<UGraphConnectedComponent*>{Split});
+	TestEqual(TEXT("Vertices of the new component removed"), Kept->Diffs[0].RemovedVertices.Num(), 2);
+	TestEqual(TEXT("New component created"), Split->NumCreated, 1);
+	if (TestEqual(TEXT("One diff for the new component"), Split->Diffs.Num(), 1))
+	{
+		TestEqual(TEXT("New component received its vertices"), Split->Diffs[0].AddedVertices.Num(), 2);
+	}
+
+	Monitor->SetCoalesceEvents(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphComponentCoalescingLazyTest, "GraphStructure.ConnectedComponents.Coalescing.Lazy",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphComponentCoalescingLazyTest::RunTest(const FString& Parameters)
+{
+	TArray<UGraphStructureVertex*> Vertices;
+	UGraphStructureEdge* Bridge;
+	UGraphStructure* Graph = CreateBridgedGraph(Vertices, Bridge);
+
+	UGraphConnectedComponentsMonitor* Monitor = CreateCoalescingMonitor(Graph);
+	UGraphRecordingConnectedComponent* Whole = GetRecordingComponent(Monitor, Vertices[0]);
+
+	// Splits are only resolved on demand, querying components would resolve them so only the flush may touch the monitor
+	Monitor->SetLazyMode(true, false);
+	Graph->RemoveEdge(Bridge);
+	TestTrue(TEXT("Split pending"), Monitor->HasPendingSplits());
+
+	Monitor->FlushComponentEvents();
+	TestFalse(TEXT("Flush resolved the split"), Monitor->HasPendingSplits());
+
+	if (!TestEqual(TEXT("One diff for the split component"), Whole->Diffs.Num(), 1))
+	{
+		return false;
+	}
+	const FGraphConnectedComponentDiff& Diff = Whole->Diffs[0];
+	if (!TestEqual(TEXT("Split into one component"), Diff.SplitInto.Num(), 1))
+	{
+		return false;
+	}
+	UGraphRecordingConnectedComponent* Split = CastChecked<UGraphRecordingConnectedComponent>(Diff.SplitInto[0]);
+	TestEqual(TEXT("New component created within the same flush"), Split->NumCreated, 1);
+	TestEqual(TEXT("Vertices of the new component removed"), Diff.RemovedVertices.Num(), 2);
+	TestTrue(TEXT("Halves in different components"),
+	         Monitor->GetConnectedComponentOfVertex(Vertices[0]) != Monitor->GetConnectedComponentOfVertex(Vertices[3]));
+
+	Monitor->SetLazyMode(false);
+	Monitor->SetCoalesceEvents(false);
+	return true;
+}
+
+#endif
@@ -0,0 +1,199 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Flow/GraphMaxFlowSolver.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	float SumMinCutCapacity(const UGraphMaxFlowSolver* Solver)
+	{
+		float Capacity = 0.0f;
+		for (const UGraphStructureEdge* Edge : Solver->GetMinCutEdges())
+		{
+			Capacity += Edge->Capacity;
+		}
+		return Capacity;
+	}
+
+	UGraphStructure* CreateGridGraph(const int32 Size)
+	{
+		UGraphStructure* Graph = NewObject<UGraphStructure>();
+		Graph->AddVerticesBulk(Size * Size);
+
+		TArray<FIntPoint> EdgeEndpoints;
+		for (int32 Y = 0; Y < Size; ++Y)
+		{
+			for (int32 X = 0; X < Size; ++X)
+			{
+				const int32 Id = Y * Size + X;
+				if (X + 1 < Size)
+				{
+					EdgeEndpoints.Add({Id, Id + 1});
+				}
+				if (Y + 1 < Size)
+				{
+					EdgeEndpoints.Add({Id, Id + Size});
+				}
+			}
+		}
+		Graph->AddEdgesBulk(EdgeEndpoints);
+		return Graph;
+	}
+
+	// Barabasi-Albert graph, every new vertex attaches to EdgesPerVertex existing vertices chosen proportional to their degree
+	UGraphStructure* CreateScaleFreeGraph(const int32 NumVertices, const int32 EdgesPerVertex, const int32 Seed)
+	{
+		UGraphStructure* Graph = NewObject<UGraphStructure>();
+		Graph->AddVerticesBulk(NumVertices);
+
+		FRandomStream RandomStream(Seed);
+		TArray<FIntPoint> EdgeEndpoints;
+		// Every edge adds both endpoints, picking a uniform entry picks a vertex proportional to its degree
+		TArray<int32> DegreeWeightedVertices;
+
+		// Start from a clique so the graph stays EdgesPerVertex-edge-connected as vertices are attached
+		for (int32 Id = 0; Id <= EdgesPerVertex; ++Id)
+		{
+			for (int32 OtherId = Id + 1; OtherId <= EdgesPerVertex; ++OtherId)
+			{
+				EdgeEndpoints.Add({Id, OtherId});
+				DegreeWeightedVertices.Append({Id, OtherId});
+			}
+		}
+		for (int32 Id = EdgesPerVertex + 1; Id < NumVertices; ++Id)
+		{
+			TArray<int32, TInlineAllocator<8>> Targets;
+			while (Targets.Num() < EdgesPerVertex)
+			{
+				Targets.AddUnique(DegreeWeightedVertices[RandomStream.RandRange(0, DegreeWeightedVertices.Num() - 1)]);
+			}
+			for (const int32 Target : Targets)
+			{
+				EdgeEndpoints.Add({Id, Target});
+				DegreeWeightedVertices.Append({Id, Target});
+			}
+		}
+		Graph->AddEdgesBulk(EdgeEndpoints);
+		return Graph;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphMaxFlowSolverKnownValueTest, "GraphStructure.Flow.MaxFlow.KnownValue",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphMaxFlowSolverKnownValueTest::RunTest(const FString& Parameters)
+{
+	// S-A-T and S-B-T with a cross edge A-B, every cut around S or T has capacity 7
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	UGraphStructureVertex* S = Graph->AddDefaultVertex();
+	UGraphStructureVertex* A = Graph->AddDefaultVertex();
+	UGraphStructureVertex* B = Graph->AddDefaultVertex();
+	UGraphStructureVertex* T = Graph->AddDefaultVertex();
+
+	auto AddEdge = [Graph](UGraphStructureVertex* Source, UGraphStructureVertex* Target, const float Capacity)
+	{
+		UGraphStructureEdge* Edge = Graph->AddDefaultEdgeBetween(Source, Target);
+		Edge->Capacity = Capacity;
+		return Edge;
+	};
+	UGraphStructureEdge* SA = AddEdge(S, A, 3.0f);
+	AddEdge(A, T, 2.0f);
+	AddEdge(S, B, 4.0f);
+	AddEdge(B, T, 5.0f);
+	AddEdge(A, B, 1.0f);
+
+	UGraphMaxFlowSolver* Solver = NewObject<UGraphMaxFlowSolver>();
+	TestEqual(TEXT("Max flow"), Solver->ComputeMaxFlow(Graph, S, T), 7.0f, KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Min cut capacity"), SumMinCutCapacity(Solver), 7.0f, KINDA_SMALL_NUMBER);
+
+	// Lowering S-A makes the cut around S the bottleneck, the warm-started solve has to match a fresh one
+	SA->Capacity = 1.0f;
+	TestEqual(TEXT("Warm-started max flow"), Solver->ComputeMaxFlow(Graph, S, T), 5.0f, KINDA_SMALL_NUMBER);
+
+	UGraphMaxFlowSolver* FreshSolver = NewObject<UGraphMaxFlowSolver>();
+	TestEqual(TEXT("Fresh max flow"), FreshSolver->ComputeMaxFlow(Graph, S, T), 5.0f, KINDA_SMALL_NUMBER);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphMaxFlowSolverGridTest, "GraphStructure.Flow.MaxFlow.Grid",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphMaxFlowSolverGridTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Size = 200;
+	UGraphStructure* Graph = CreateGridGraph(Size);
+	UGraphStructureVertex* Source = Graph->GetVertexById(0);
+	UGraphStructureVertex* Sink = Graph->GetVertexById(Size * Size - 1);
+
+	UGraphMaxFlowSolver* Solver = NewObject<UGraphMaxFlowSolver>();
+
+	const double StartTime = FPlatformTime::Seconds();
+	const float MaxFlow = Solver->ComputeMaxFlow(Graph, Source, Sink);
+	const double SolveTime = FPlatformTime::Seconds() - StartTime;
+
+	// Opposite corners have two edges each, they are the bottleneck
+	TestEqual(TEXT("Max flow"), MaxFlow, 2.0f, KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Min cut capacity"), SumMinCutCapacity(Solver), MaxFlow, KINDA_SMALL_NUMBER);
+
+	// Removing an edge next to the sink halves the flow, the warm start only has to repair the flow through that edge
+	Graph->RemoveEdge(Graph->GetEdgeBetween(Sink, Graph->GetVertexById(Size * Size - 2)));
+
+	const double WarmStartTime = FPlatformTime::Seconds();
+	const float WarmMaxFlow = Solver->ComputeMaxFlow(Graph, Source, Sink);
+	const double WarmSolveTime = FPlatformTime::Seconds() - WarmStartTime;
+
+	TestEqual(TEXT("Warm-started max flow"), WarmMaxFlow, 1.0f, KINDA_SMALL_NUMBER);
+
+	AddInfo(FString::Printf(TEXT("%dx%d grid: cold solve %.2f ms, warm-started solve %.2f ms"), Size, Size, SolveTime * 1000.0,
+	                        WarmSolveTime * 1000.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphMaxFlowSolverScaleFreeTest, "GraphStructure.Flow.MaxFlow.ScaleFree",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphMaxFlowSolverScaleFreeTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumVertices = 20000;
+	constexpr int32 EdgesPerVertex = 3;
+	UGraphStructure* Graph = CreateScaleFreeGraph(NumVertices, EdgesPerVertex, 42);
+
+	// The newest vertex has exactly EdgesPerVertex edges and the graph is EdgesPerVertex-edge-connected, so that is the max flow
+	UGraphStructureVertex* Source = Graph->GetVertexById(0);
+	UGraphStructureVertex* Sink = Graph->GetVertexById(NumVertices - 1);
+
+	UGraphMaxFlowSolver* Solver = NewObject<UGraphMaxFlowSolver>();
+
+	const double StartTime = FPlatformTime::Seconds();
+	const float MaxFlow = Solver->ComputeMaxFlow(Graph, Source, Sink);
+	const double SolveTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Max flow"), MaxFlow, static_cast<float>(EdgesPerVertex), KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Min cut capacity"), SumMinCutCapacity(Solver), MaxFlow, KINDA_SMALL_NUMBER);
+
+	// Removing one edge of the sink lowers the flow by one, the warm-started solve has to match a cold solve of the changed graph
+	Graph->RemoveEdge(Graph->GetVertexById(NumVertices - 1)->Adjacency.Array()[0]);
+
+	const double WarmStartTime = FPlatformTime::Seconds();
+	const float WarmMaxFlow = Solver->ComputeMaxFlow(Graph, Source, Sink);
+	const double WarmSolveTime = FPlatformTime::Seconds() - WarmStartTime;
+
+	UGraphMaxFlowSolver* ColdSolver = NewObject<UGraphMaxFlowSolver>();
+	const double ColdStartTime = FPlatformTime::Seconds();
+	const float ColdMaxFlow = ColdSolver->ComputeMaxFlow(Graph, Source, Sink);
+	const double ColdSolveTime = FPlatformTime::Seconds() - ColdStartTime;
+
+	TestEqual(TEXT("Warm-started max flow"), WarmMaxFlow, static_cast<float>(EdgesPerVertex - 1), KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Warm-started matches cold"), WarmMaxFlow, ColdMaxFlow, KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Warm-started min cut capacity"), SumMinCutCapacity(Solver), WarmMaxFlow, KINDA_SMALL_NUMBER);
+
+	AddInfo(FString::Printf(TEXT("Scale-free graph with %d vertices: solve %.2f ms, after removing a sink edge warm-started %.2f ms, "
+	                             "cold %.2f ms"), NumVertices, SolveTime * 1000.0, WarmSolveTime * 1000.0, ColdSolveTime * 1000.0));
+	return true;
+}
+
+#endif
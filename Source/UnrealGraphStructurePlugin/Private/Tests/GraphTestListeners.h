@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ConnectedComponents/GraphConnectedComponent.h"
+#include "UObject/NoExportTypes.h"
+#include "GraphTestListeners.generated.h"
+
+/**
+ * Records the events of a UGraphCentralityAnalyzer for automation tests
+ */
+UCLASS(Transient, NotBlueprintable, HideDropdown)
+class UGraphCentralityTestListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	int32 NumCompletions = 0;
+
+	int32 LastNumSampledSources = 0;
+
+	UFUNCTION()
+	void HandleCompleted(int32 NumSampledSources)
+	{
+		++NumCompletions;
+		LastNumSampledSources = NumSampledSources;
+	}
+};
+
+/**
+ * Records the events a connected component receives from its monitor for automation tests
+ */
+UCLASS(Transient, NotBlueprintable, HideDropdown)
+class UGraphRecordingConnectedComponent : public UGraphConnectedComponent
+{
+	GENERATED_BODY()
+
+public:
+	int32 NumCreated = 0;
+
+	int32 NumDestroyed = 0;
+
+	int32 NumVertexEvents = 0;
+
+	UPROPERTY()
+	TArray<FGraphConnectedComponentDiff> Diffs;
+
+	int32 NumEvents() const
+	{
+		return NumCreated + NumDestroyed + NumVertexEvents + Diffs.Num();
+	}
+
+	void ResetRecording()
+	{
+		NumCreated = 0;
+		NumDestroyed = 0;
+		NumVertexEvents = 0;
+		Diffs.Reset();
+	}
+
+protected:
+	virtual void OnCreated_Implementation() override
+	{
+		++NumCreated;
+	}
+
+	virtual void OnDestroyed_Implementation() override
+	{
+		++NumDestroyed;
+	}
+
+	virtual void OnVertexAdded_Implementation(UGraphStructureVertex* Vertex) override
+	{
+		++NumVertexEvents;
+	}
+
+	virtual void OnVertexRemoved_Implementation(UGraphStructureVertex* Vertex) override
+	{
+		++NumVertexEvents;
+	}
+
+	virtual void OnChanged_Implementation(const FGraphConnectedComponentDiff& Diff) override
+	{
+		Diffs.Add(Diff);
+	}
+};
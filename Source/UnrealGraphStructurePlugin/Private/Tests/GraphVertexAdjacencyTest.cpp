@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GraphStructure.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphVertexAdjacencyHubTest, "GraphStructure.Adjacency.Hub",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphVertexAdjacencyHubTest::RunTest(const FString& Parameters)
+{
+	// Grow a hub past the hash threshold and shrink it back, lookups have to keep working on both sides
+	constexpr int32 NumLeaves = 40;
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	UGraphStructureVertex* Hub = Graph->AddDefaultVertex();
+	TArray<UGraphStructureEdge*> HubEdges;
+	for (int32 i = 0; i < NumLeaves; ++i)
+	{
+		HubEdges.Add(Graph->AddDefaultEdgeBetween(Hub, Graph->AddDefaultVertex()));
+	}
+
+	TestEqual(TEXT("Hub degree"), Hub->Adjacency.Num(), NumLeaves);
+	TestFalse(TEXT("Duplicate add"), Hub->Adjacency.Add(HubEdges[7]));
+	for (UGraphStructureEdge* Edge : HubEdges)
+	{
+		TestTrue(TEXT("Hub contains edge"), Hub->Adjacency.Contains(Edge));
+	}
+
+	for (int32 i = 0; i < NumLeaves - 3; ++i)
+	{
+		TestTrue(TEXT("Edge removed"), Graph->RemoveEdge(HubEdges[i]));
+		TestFalse(TEXT("Removed edge not contained"), Hub->Adjacency.Contains(HubEdges[i]));
+	}
+	Graph->Shrink();
+
+	TestEqual(TEXT("Remaining degree"), Hub->Adjacency.Num(), 3);
+	for (int32 i = NumLeaves - 3; i < NumLeaves; ++i)
+	{
+		TestTrue(TEXT("Remaining edge contained"), Hub->Adjacency.Contains(HubEdges[i]));
+	}
+	TestEqual(TEXT("Small adjacency uses inline storage only"), Hub->Adjacency.GetAllocatedSize(), static_cast<SIZE_T>(0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphVertexAdjacencyMemoryTest, "GraphStructure.Adjacency.Memory",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphVertexAdjacencyMemoryTest::RunTest(const FString& Parameters)
+{
+	// A ring with chords gives every vertex degree 3, the typical case the compact adjacency is meant for
+	constexpr int32 NumVertices = 10000;
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	Graph->AddVerticesBulk(NumVertices);
+
+	TArray<FIntPoint> EdgeEndpoints;
+	for (int32 Id = 0; Id < NumVertices; ++Id)
+	{
+		EdgeEndpoints.Add({Id, (Id + 1) % NumVertices});
+	}
+	for (int32 Id = 0; Id < NumVertices / 2; ++Id)
+	{
+		EdgeEndpoints.Add({Id, Id + NumVertices / 2});
+	}
+	Graph->AddEdgesBulk(EdgeEndpoints);
+
+	// Compare against the hashed set every vertex used to carry
+	SIZE_T AdjacencyBytes = 0;
+	SIZE_T SetBytes = 0;
+	for (const UGraphStructureVertex* Vertex : Graph->GetVertexArray())
+	{
+		TestEqual(TEXT("Degree"), Vertex->Adjacency.Num(), 3);
+
+		const TSet<UGraphStructureEdge*> EdgeSet(Vertex->Adjacency.Array());
+		AdjacencyBytes += sizeof(FGraphVertexAdjacency) + Vertex->Adjacency.GetAllocatedSize();
+		SetBytes += sizeof(TSet<UGraphStructureEdge*>) + EdgeSet.GetAllocatedSize();
+	}
+
+	AddInfo(FString::Printf(TEXT("Degree 3 vertices: %.1f bytes per adjacency, %.1f bytes per TSet"),
+	                        static_cast<double>(AdjacencyBytes) / NumVertices, static_cast<double>(SetBytes) / NumVertices));
+	TestTrue(TEXT("Adjacency is smaller than a TSet"), AdjacencyBytes < SetBytes);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphVertexAdjacencyDuplicateTest, "GraphStructure.Adjacency.Duplicate",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphVertexAdjacencyDuplicateTest::RunTest(const FString& Parameters)
+{
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	UGraphStructureVertex* A = Graph->AddDefaultVertex();
+	UGraphStructureVertex* B = Graph->AddDefaultVertex();
+	UGraphStructureVertex* C = Graph->AddDefaultVertex();
+	Graph->AddDefaultEdgeBetween(A, B);
+	Graph->AddDefaultEdgeBetween(B, C);
+
+	// Adjacency isn't serialized, the copy has to rebuild it from its own edges
+	UGraphStructure* Copy = DuplicateObject<UGraphStructure>(Graph, GetTransientPackage());
+	UGraphStructureVertex* CopyB = Copy->GetVertexById(B->GraphId);
+	TestEqual(TEXT("Degree of copy"), CopyB->Adjacency.Num(), 2);
+	for (const UGraphStructureEdge* Edge : CopyB->Adjacency)
+	{
+		TestTrue(TEXT("Copy references its own edges"), Copy->ContainsEdge(Edge));
+	}
+	TestTrue(TEXT("Copy has path"), Copy->HasEdgeBetween(Copy->GetVertexById(A->GraphId), CopyB));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ConnectedComponents/GraphConnectedComponentsMonitor.h"
+#include "Misc/AutomationTest.h"
+#include "SpanningForest/GraphSpanningForestMonitor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphVertexRemovalMonitorsTest, "GraphStructure.Removal.VertexWithMonitors",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGraphVertexRemovalMonitorsTest::RunTest(const FString& Parameters)
+{
+	// A hub connected to 8 leaves, the leaves are paired up by heavy edges so removing the hub leaves 4 components
+	constexpr int32 NumLeaves = 8;
+	UGraphStructure* Graph = NewObject<UGraphStructure>();
+	UGraphStructureVertex* Hub = Graph->AddDefaultVertex();
+	TArray<UGraphStructureVertex*> Leaves;
+	for (int32 i = 0; i < NumLeaves; ++i)
+	{
+		Leaves.Add(Graph->AddDefaultVertex());
+		Graph->AddDefaultEdgeBetween(Hub, Leaves.Last());
+	}
+	for (int32 i = 0; i < NumLeaves; i += 2)
+	{
+		Graph->AddDefaultEdgeBetween(Leaves[i], Leaves[i + 1])->Weight = 5.0f;
+	}
+
+	UGraphConnectedComponentsMonitor* ComponentsMonitor = NewObject<UGraphConnectedComponentsMonitor>();
+	ComponentsMonitor->Setup(Graph, UGraphConnectedComponent::StaticClass());
+	UGraphSpanningForestMonitor* ForestMonitor = NewObject<UGraphSpanningForestMonitor>();
+	ForestMonitor->Setup(Graph);
+
+	TestEqual(TEXT("Components before"), ComponentsMonitor->GetAllUsedConnectedComponents().Num(), 1);
+	TestEqual(TEXT("Forest weight before"), ForestMonitor->GetTotalWeight(), static_cast<float>(NumLeaves));
+
+	// The hub edges are reported both in one batch and one by one, each of them must only be handled once
+	TestTrue(TEXT("Hub removed"), Graph->RemoveVertex(Hub));
+
+	TestEqual(TEXT("Components after"), ComponentsMonitor->GetAllUsedConnectedComponents().Num(), NumLeaves / 2);
+	TestEqual(TEXT("Forest edges after"), ForestMonitor->GetForestEdges().Num(), NumLeaves / 2);
+	TestEqual(TEXT("Forest weight after"), ForestMonitor->GetTotalWeight(), 5.0f * (NumLeaves / 2));
+
+	// Monitors set up on the resulting graph have to agree
+	UGraphConnectedComponentsMonitor* FreshComponentsMonitor = NewObject<UGraphConnectedComponentsMonitor>();
+	FreshComponentsMonitor->Setup(Graph, UGraphConnectedComponent::StaticClass());
+	UGraphSpanningForestMonitor* FreshForestMonitor = NewObject<UGraphSpanningForestMonitor>();
+	FreshForestMonitor->Setup(Graph);
+
+	TestEqual(TEXT("Components match fresh monitor"), ComponentsMonitor->GetAllUsedConnectedComponents().Num(),
+	          FreshComponentsMonitor->GetAllUsedConnectedComponents().Num());
+	TestEqual(TEXT("Forest weight matches fresh monitor"), ForestMonitor->GetTotalWeight(), FreshForestMonitor->GetTotalWeight());
+
+	for (int32 i = 0; i < NumLeaves; i += 2)
+	{
+		TestEqual(TEXT("Paired leaves share a component"), ComponentsMonitor->GetConnectedComponentOfVertex(Leaves[i]),
+		          ComponentsMonitor->GetConnectedComponentOfVertex(Leaves[i + 1]));
+	}
+
+	return true;
+}
+
+#endif
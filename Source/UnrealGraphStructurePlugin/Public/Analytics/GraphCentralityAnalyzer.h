@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GraphStructure.h"
+#include "UObject/NoExportTypes.h"
+#include "GraphCentralityAnalyzer.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGraphCentralityAnalyzer_OnCompleted_Signature, int32, NumSampledSources);
+
+struct FGraphCentralityTask;
+
+/**
+ * Estimates betweenness and harmonic closeness centrality of all vertices by running Brandes' algorithm from a random sample of
+ * source vertices and scaling the accumulated scores up to the whole graph.
+ * The sample size follows from the error budget as ln(n) / Epsilon^2 sources, all sources are used if that exceeds the vertex count
+ * which yields exact scores. Sources are processed in parallel on a snapshot of the graph taken when the estimation is started,
+ * scores are written to vertex float attributes on the game thread once done.
+ */
+UCLASS(BlueprintType)
+class UNREALGRAPHSTRUCTUREPLUGIN_API UGraphCentralityAnalyzer : public UObject
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UGraphStructure* RunningGraph;
+
+	// Vertices of the snapshot in order of their GraphId at the time, kept to map scores back if the graph changes meanwhile
+	UPROPERTY()
+	TArray<UGraphStructureVertex*> SnapshotVertices;
+
+	FName RunningBetweennessAttribute;
+
+	FName RunningClosenessAttribute;
+
+	TSharedPtr<FGraphCentralityTask> RunningTask;
+
+	void CompleteEstimation();
+
+	void WriteScores(FName Attribute, const TArray<float>& Scores);
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FGraphCentralityAnalyzer_OnCompleted_Signature OnCompleted;
+
+	virtual void BeginDestroy() override;
+
+	// Start estimating in the background, either attribute may be None to skip it. Missing attributes are added as vertex float
+	// attributes. Sampling stops early once TimeBudgetSeconds have passed if it is positive, the scores are then scaled by the number
+	// of sources that could be processed. Returns false if an estimation is already running or the parameters are invalid
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Analytics")
+	bool EstimateCentrality(UGraphStructure* Graph, FName BetweennessAttribute, FName ClosenessAttribute, float Epsilon = 0.05f,
+	                        float TimeBudgetSeconds = 0.0f, int32 Seed = 0);
+
+	// Abandon the running estimation, no scores are written and OnCompleted is not broadcast
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Analytics")
+	void Cancel();
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Analytics")
+	bool IsRunning() const;
+};
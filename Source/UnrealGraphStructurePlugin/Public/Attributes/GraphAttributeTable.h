@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GraphAttributeTable.generated.h"
+
+UENUM(BlueprintType)
+enum class EGraphAttributeType : uint8
+{
+	Float,
+	Int,
+	Vector,
+	Bool
+};
+
+/**
+ * Typed attribute columns stored as struct-of-arrays, row i of every column belongs to the graph element with the dense id i.
+ * Rows are removed by swapping in the last row, mirroring how the graph keeps its element ids dense.
+ * Bulk operations work on the contiguous column memory and are vectorized where it pays off.
+ */
+class UNREALGRAPHSTRUCTUREPLUGIN_API FGraphAttributeTable
+{
+	int32 NumRows = 0;
+
+	TMap<FName, TArray<float>> FloatColumns;
+	TMap<FName, TArray<int32>> IntColumns;
+	TMap<FName, TArray<FVector>> VectorColumns;
+	TMap<FName, TBitArray<>> BoolColumns;
+
+	template <typename T>
+	TMap<FName, TArray<T>>& GetColumnMap();
+
+	template <typename T>
+	const TMap<FName, TArray<T>>& GetColumnMap() const
+	{
+		return const_cast<FGraphAttributeTable*>(this)->GetColumnMap<T>();
+	}
+
+public:
+	int32 Num() const
+	{
+		return NumRows;
+	}
+
+	// Columns
+
+	// Add a zero initialized column, fails if a column with this name already exists regardless of its type
+	bool AddColumn(FName Name, EGraphAttributeType Type);
+
+	bool RemoveColumn(FName Name);
+
+	bool HasColumn(FName Name) const;
+
+	bool HasColumn(FName Name, EGraphAttributeType Type) const;
+
+	// Typed column access, returns an empty view if there is no column of that name and type
+	template <typename T>
+	TArrayView<T> GetColumn(const FName Name)
+	{
+		TArray<T>* Column = GetColumnMap<T>().Find(Name);
+		return Column != nullptr ? TArrayView<T>(*Column) : TArrayView<T>();
+	}
+
+	template <typename T>
+	TConstArrayView<T> GetColumn(const FName Name) const
+	{
+		const TArray<T>* Column = GetColumnMap<T>().Find(Name);
+		return Column != nullptr ? TConstArrayView<T>(*Column) : TConstArrayView<T>();
+	}
+
+	TBitArray<>* GetBoolColumn(FName Name);
+
+	const TBitArray<>* GetBoolColumn(FName Name) const;
+
+	// Rows, managed by the owning graph
+
+	void AddRows(int32 Count);
+
+	void RemoveRowSwap(int32 Row);
+
+	void Reserve(int32 Rows);
+
+	void Shrink();
+
+	void Reset();
+
+	// Bulk operations, all return false or a neutral value if the column doesn't exist
+
+	bool SetFloatColumn(FName Name, TConstArrayView<float> Values);
+
+	bool FillFloatColumn(FName Name, float Value);
+
+	bool ScaleFloatColumn(FName Name, float Factor);
+
+	double SumFloatColumn(FName Name) const;
+
+	bool MinMaxFloatColumn(FName Name, float& OutMin, float& OutMax) const;
+
+	int64 SumIntColumn(FName Name) const;
+
+	FVector SumVectorColumn(FName Name) const;
+
+	int32 CountTrue(FName Name) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+	// Columns whose length doesn't match the row count after loading are resized, so a damaged table can't break the row invariant
+	friend UNREALGRAPHSTRUCTUREPLUGIN_API FArchive& operator<<(FArchive& Ar, FGraphAttributeTable& Table);
+};
+
+template <>
+inline TMap<FName, TArray<float>>& FGraphAttributeTable::GetColumnMap<float>()
+{
+	return FloatColumns;
+}
+
+template <>
+inline TMap<FName, TArray<int32>>& FGraphAttributeTable::GetColumnMap<int32>()
+{
+	return IntColumns;
+}
+
+template <>
+inline TMap<FName, TArray<FVector>>& FGraphAttributeTable::GetColumnMap<FVector>()
+{
+	return VectorColumns;
+}
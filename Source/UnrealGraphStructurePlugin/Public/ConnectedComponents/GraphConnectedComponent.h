@@ -8,6 +8,109 @@
 #include "UObject/NoExportTypes.h"
 #include "GraphConnectedComponent.generated.h"
 
+/**
+ * Sum, count, minimum and maximum of the values a channel holds for the vertices of a component
+ */
+USTRUCT(BlueprintType)
+struct UNREALGRAPHSTRUCTUREPLUGIN_API FGraphComponentAggregate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	double Sum = 0.0;
+
+	// Number of vertices that have a value in the channel
+	UPROPERTY(BlueprintReadOnly)
+	int32 Count = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Min = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Max = 0.0f;
+
+	// Number of values equal to Min and Max, removing values only has to touch the value heaps of the component once the last extreme
+	// value is gone
+	int32 MinCount = 0;
+	int32 MaxCount = 0;
+
+	void Add(float Value);
+
+	// Returns false if the last value equal to Min or Max has been removed and the aggregate has to be recomputed
+	bool Remove(float Value);
+
+	void Combine(const FGraphComponentAggregate& Other);
+
+	// Remove an aggregate of a subset of the values, returns false if the aggregate has to be recomputed like Remove
+	bool Subtract(const FGraphComponentAggregate& Part);
+};
+
+/**
+ * Min and max heaps over the values a channel holds for the vertices of a component, so the aggregate can recover its extrema after
+ * the last extreme value is gone without visiting every vertex. Entries are not removed when a value changes, moves or is cleared,
+ * they go stale and are dropped once they reach the top or outnumber the current ones
+ */
+struct UNREALGRAPHSTRUCTUREPLUGIN_API FGraphComponentValueHeaps
+{
+	struct FEntry
+	{
+		float Value;
+
+		// Stamp of the vertex value when the entry was pushed, the entry is current as long as the channel holds the same stamp
+		uint32 Stamp;
+
+		// Only used as a key, stale entries may outlive their vertex
+		UGraphStructureVertex* Vertex;
+	};
+
+	TArray<FEntry> MinHeap;
+	TArray<FEntry> MaxHeap;
+
+	void Push(float Value, uint32 Stamp, UGraphStructureVertex* Vertex);
+
+	// Take over all entries of Other, the smaller heaps are pushed into the larger ones
+	void Append(FGraphComponentValueHeaps&& Other);
+
+	// Set Min, Max and their counts of the aggregate from the current entries, the aggregate must not be empty
+	void RecoverExtrema(TFunctionRef<bool(const FEntry&)> IsCurrent, FGraphComponentAggregate& Aggregate);
+
+	// Rebuild the heaps from their current entries once stale entries make up most of them
+	void CompactIfStale(TFunctionRef<bool(const FEntry&)> IsCurrent, int32 NumCurrent);
+
+	void Reset();
+
+	void Shrink();
+
+	SIZE_T GetAllocatedSize() const;
+};
+
+class UGraphConnectedComponent;
+
+/**
+ * Net membership changes of a component over a frame, delivered when the monitor coalesces events.
+ * Vertices that were added and removed again within the frame are in neither list, components that only existed during the frame are
+ * not listed as merge or split partners
+ */
+USTRUCT(BlueprintType)
+struct UNREALGRAPHSTRUCTUREPLUGIN_API FGraphConnectedComponentDiff
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<UGraphStructureVertex*> AddedVertices;
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<UGraphStructureVertex*> RemovedVertices;
+
+	// Components whose vertices were all moved into this component
+	UPROPERTY(BlueprintReadOnly)
+	TArray<UGraphConnectedComponent*> MergedFrom;
+
+	// Components that were split off this component
+	UPROPERTY(BlueprintReadOnly)
+	TArray<UGraphConnectedComponent*> SplitInto;
+};
+
 class UGraphConnectedComponentsMonitor;
 /**
  * 
@@ -21,22 +124,54 @@ class UNREALGRAPHSTRUCTUREPLUGIN_API UGraphConnectedComponent : public UObjectWi
 	UPROPERTY()
 	TSet<UGraphStructureVertex*> Vertices;
 
+	UPROPERTY()
+	TMap<FName, FGraphComponentAggregate> Aggregates;
+
+	// Not reflected, the heaps only hold vertices as keys which are kept alive by the monitor
+	TMap<FName, FGraphComponentValueHeaps> ValueHeaps;
+
+	void ResolvePendingSplits();
+
+	void Shrink();
+
 protected:
-	// Implementable functions
+	// Implementable functions, native events so C++ subclasses can implement them as well. The default implementations do nothing
 
-	UFUNCTION(BlueprintImplementableEvent)
+	UFUNCTION(BlueprintNativeEvent)
 	void OnCreated();
 
-	UFUNCTION(BlueprintImplementableEvent)
+	UFUNCTION(BlueprintNativeEvent)
 	void OnDestroyed();
 
-	UFUNCTION(BlueprintImplementableEvent)
+	UFUNCTION(BlueprintNativeEvent)
 	void OnVertexAdded(UGraphStructureVertex* Vertex);
 
-	UFUNCTION(BlueprintImplementableEvent)
+	UFUNCTION(BlueprintNativeEvent)
 	void OnVertexRemoved(UGraphStructureVertex* Vertex);
 
+	// Called once per frame instead of OnVertexAdded and OnVertexRemoved while the monitor coalesces events
+	UFUNCTION(BlueprintNativeEvent)
+	void OnChanged(const FGraphConnectedComponentDiff& Diff);
+
+	virtual void OnCreated_Implementation();
+
+	virtual void OnDestroyed_Implementation();
+
+	virtual void OnVertexAdded_Implementation(UGraphStructureVertex* Vertex);
+
+	virtual void OnVertexRemoved_Implementation(UGraphStructureVertex* Vertex);
+
+	virtual void OnChanged_Implementation(const FGraphConnectedComponentDiff& Diff);
+
 public:
 	UFUNCTION(BlueprintPure)
 	TSet<UGraphStructureVertex*> GetVertices();
+
+	// Aggregate of the vertex values of an aggregate channel registered at the monitor
+	UFUNCTION(BlueprintPure)
+	FGraphComponentAggregate GetAggregate(FName Channel);
+
+	SIZE_T GetAllocatedSize() const;
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 };
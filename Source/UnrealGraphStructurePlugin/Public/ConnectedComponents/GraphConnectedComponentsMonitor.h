@@ -8,6 +8,61 @@
 #include "UObject/NoExportTypes.h"
 #include "GraphConnectedComponentsMonitor.generated.h"
 
+/**
+ * Per-vertex values of an aggregate channel, only vertices that have been assigned a value are contained
+ */
+USTRUCT()
+struct FGraphAggregateChannel
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TMap<UGraphStructureVertex*, float> VertexValues;
+
+	// Stamp of every value in VertexValues, renewed whenever the value changes or its vertex is split off, so older entries in the
+	// value heaps of the components go stale
+	TMap<UGraphStructureVertex*, uint32> ValueStamps;
+
+	uint32 NextStamp = 0;
+};
+
+/**
+ * Vertices next to edges removed from a component while in lazy mode, the component has not been checked for splits yet
+ */
+USTRUCT()
+struct FGraphPendingSplit
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UGraphStructureVertex*> StartVertices;
+};
+
+/**
+ * Changes to a component recorded while coalescing events, additions and removals of the same vertex cancel out
+ */
+USTRUCT()
+struct FGraphComponentChangeRecord
+{
+	GENERATED_BODY()
+
+	bool bCreated = false;
+
+	bool bDestroyed = false;
+
+	UPROPERTY()
+	TSet<UGraphStructureVertex*> AddedVertices;
+
+	UPROPERTY()
+	TSet<UGraphStructureVertex*> RemovedVertices;
+
+	UPROPERTY()
+	TSet<UGraphConnectedComponent*> MergedFrom;
+
+	UPROPERTY()
+	TSet<UGraphConnectedComponent*> SplitInto;
+};
+
 /**
  * 
  */
@@ -27,6 +82,35 @@ class UNREALGRAPHSTRUCTUREPLUGIN_API UGraphConnectedComponentsMonitor : public U
 	UPROPERTY()
 	TSubclassOf<UGraphConnectedComponent> ConnectedComponentClass;
 
+	UPROPERTY()
+	TMap<FName, FGraphAggregateChannel> AggregateChannels;
+
+	// Lazy mode
+
+	bool bLazyMode = false;
+
+	bool bResolveAtEndOfFrame = false;
+
+	UPROPERTY()
+	TMap<UGraphConnectedComponent*, FGraphPendingSplit> PendingSplits;
+
+	// Event coalescing
+
+	bool bCoalesceEvents = false;
+
+	// Also keeps components destroyed during the frame alive until their events have been delivered
+	UPROPERTY()
+	TMap<UGraphConnectedComponent*, FGraphComponentChangeRecord> PendingChanges;
+
+	FDelegateHandle EndOfFrameHandle;
+
+	void HandleEndOfFrame();
+
+	// Bytes allocated by the monitors own containers, without its components
+	SIZE_T GetOwnAllocatedSize() const;
+
+	void UpdateEndOfFrameBinding();
+
 	// Internal functions that additionally call implementable functions of the ConnectedComponents
 
 	UGraphConnectedComponent* ConnectedComponent_Spawn();
@@ -37,6 +121,29 @@ class UNREALGRAPHSTRUCTUREPLUGIN_API UGraphConnectedComponentsMonitor : public U
 
 	void ConnectedComponent_RemoveVertex(UGraphConnectedComponent* ConnectedComponent, UGraphStructureVertex* Vertex);
 
+	// Move vertices from one component to another. Merges combine aggregates and value heaps as a whole, splits only visit the moved
+	// vertices and recover the extrema of the remaining part from its value heaps
+	void ConnectedComponent_MoveVertices(UGraphConnectedComponent* FromConnectedComponent, UGraphConnectedComponent* ToConnectedComponent,
+	                                     const TSet<UGraphStructureVertex*>& MoveVertices);
+
+	// Split off every part of the component that became disconnected from the others, given vertices next to all removed edges.
+	// Runs one interleaved search per start vertex, searches that meet are merged and the search stops as soon as only one is left
+	// unfinished. Finished searches each found a complete new component, the unfinished one keeps the existing component.
+	void ConnectedComponent_SplitDisconnected(UGraphConnectedComponent* ConnectedComponent, const TArray<UGraphStructureVertex*>& StartVertices);
+
+	// Split immediately or, in lazy mode, remember the start vertices and mark the component dirty
+	void ConnectedComponent_HandleEdgesRemoved(UGraphConnectedComponent* ConnectedComponent, const TArray<UGraphStructureVertex*>& StartVertices);
+
+	// Aggregate functions
+
+	// Stamp the value of the vertex and push it onto the value heaps of its component
+	void Aggregate_PushValue(UGraphConnectedComponent* ConnectedComponent, FName Channel, UGraphStructureVertex* Vertex, float Value);
+
+	// Recover the extrema from the value heaps if the last extreme value is gone and drop stale heap entries once they pile up
+	void Aggregate_UpdateHeaps(UGraphConnectedComponent* ConnectedComponent, FName Channel, bool bRecoverExtrema);
+
+	void Aggregate_RemoveValue(UGraphConnectedComponent* ConnectedComponent, FName Channel, float Value);
+
 	// Functions for binding to graph delegates
 
 	UFUNCTION()
@@ -51,10 +158,80 @@ class UNREALGRAPHSTRUCTUREPLUGIN_API UGraphConnectedComponentsMonitor : public U
 	UFUNCTION()
 	void GraphStructure_EdgeRemoved(UGraphStructureEdge* Edge);
 
+	UFUNCTION()
+	void GraphStructure_VertexEdgesRemoved(UGraphStructureVertex* Vertex, const TArray<UGraphStructureEdge*>& Edges);
+
+	UFUNCTION()
+	void GraphStructure_BulkAdded(const TArray<UGraphStructureVertex*>& NewVertices, const TArray<UGraphStructureEdge*>& NewEdges);
+
 public:
+	virtual void BeginDestroy() override;
+
 	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents")
 	void Setup(UGraphStructure* MonitorGraph, TSubclassOf<UGraphConnectedComponent> ConnectedCompClass);
 
 	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents")
 	TSet<UGraphConnectedComponent*> GetAllUsedConnectedComponents();
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents")
+	UGraphConnectedComponent* GetConnectedComponentOfVertex(UGraphStructureVertex* Vertex);
+
+	// Lazy mode
+
+	// In lazy mode edge removals only mark their component dirty, all removals of a component are then checked for splits together
+	// with a single search on the next query or, if bResolveAtEndOfFrame is set, at the end of the frame
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents|Lazy")
+	void SetLazyMode(bool bEnabled, bool bResolveAtEndOfFrameIfEnabled = true);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|ConnectedComponents|Lazy")
+	bool IsLazyMode() const;
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|ConnectedComponents|Lazy")
+	bool HasPendingSplits() const;
+
+	// Split all dirty components now, called automatically before any query
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents|Lazy")
+	void ResolvePendingSplits();
+
+	// Event coalescing
+
+	// While coalescing, component events are recorded instead of being called right away and delivered at the end of the frame:
+	// OnCreated for components created during the frame, a single OnChanged with the net diff of every changed component and
+	// OnDestroyed for components destroyed during the frame. Components created and destroyed within the same frame get no events
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents|Events")
+	void SetCoalesceEvents(bool bEnabled);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|ConnectedComponents|Events")
+	bool IsCoalescingEvents() const;
+
+	// Deliver the recorded component events now instead of at the end of the frame, pending lazy splits are resolved first
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents|Events")
+	void FlushComponentEvents();
+
+	// Memory
+
+	// Bytes allocated by the monitor including its components
+	SIZE_T GetAllocatedSize() const;
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	// Release slack left in the vertex maps and component vertex sets, e.g. after removing many vertices or splitting large components
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents|Memory")
+	void Shrink();
+
+	// Aggregates
+
+	// Register a channel whose per-vertex values are aggregated for every component
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents|Aggregates")
+	void AddAggregateChannel(FName Channel);
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents|Aggregates")
+	bool SetVertexValue(FName Channel, UGraphStructureVertex* Vertex, float Value);
+
+	// Remove the value of a vertex so it no longer contributes to the aggregate of its component
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|ConnectedComponents|Aggregates")
+	bool ClearVertexValue(FName Channel, UGraphStructureVertex* Vertex);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|ConnectedComponents|Aggregates")
+	bool GetVertexValue(FName Channel, UGraphStructureVertex* Vertex, float& Value);
 };
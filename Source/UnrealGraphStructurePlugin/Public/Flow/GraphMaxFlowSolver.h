@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GraphStructure.h"
+#include "UObject/NoExportTypes.h"
+#include "GraphMaxFlowSolver.generated.h"
+
+/**
+ * Computes maximum flows and minimum cuts between two vertices of a graph using Dinic's algorithm.
+ * Edges are treated as undirected and may carry up to their Capacity in either direction.
+ * The flow of the last solve is kept so that solving again for the same source and sink after small changes to the graph
+ * starts from the previous flow instead of from zero.
+ */
+UCLASS(BlueprintType)
+class UNREALGRAPHSTRUCTUREPLUGIN_API UGraphMaxFlowSolver : public UObject
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UGraphStructure* LastGraph;
+
+	UPROPERTY()
+	UGraphStructureVertex* LastSource;
+
+	UPROPERTY()
+	UGraphStructureVertex* LastSink;
+
+	// Flow per edge of the last solve, positive values flow from the edges Source to its Target
+	UPROPERTY()
+	TMap<UGraphStructureEdge*, float> EdgeFlows;
+
+	UPROPERTY()
+	TSet<UGraphStructureEdge*> MinCutEdges;
+
+	float MaxFlowValue = 0.0f;
+
+public:
+	// Compute the maximum flow from SourceVertex to SinkVertex, warm-starts from the previous flow if graph, source and sink are unchanged.
+	// Capacities are read from the edge float attribute CapacityAttribute or from the edges Capacity if it is None
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Flow")
+	float ComputeMaxFlow(UGraphStructure* Graph, UGraphStructureVertex* SourceVertex, UGraphStructureVertex* SinkVertex,
+	                     FName CapacityAttribute = NAME_None);
+
+	// Discard the previous flow so the next solve starts from zero
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Flow")
+	void Reset();
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Flow")
+	float GetMaxFlowValue() const;
+
+	// Flow through Edge in the last solve, positive if flowing from the edges Source to its Target
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Flow")
+	float GetEdgeFlow(UGraphStructureEdge* Edge) const;
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Flow")
+	TMap<UGraphStructureEdge*, float> GetEdgeFlows() const;
+
+	// Edges separating the vertices still reachable from the source in the residual network from the rest, i.e. the bottleneck
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Flow")
+	TSet<UGraphStructureEdge*> GetMinCutEdges() const;
+};
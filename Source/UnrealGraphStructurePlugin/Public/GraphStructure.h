@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Attributes/GraphAttributeTable.h"
 #include "GraphStructureEdge.h"
 #include "GraphStructureVertex.h"
 #include "UObject/NoExportTypes.h"
@@ -16,6 +17,32 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGraphStructure_OnEdgeAdded_Signatur
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGraphStructure_OnEdgeRemoved_Signature, UGraphStructureEdge*, Edge);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGraphStructure_OnVertexEdgesRemoved_Signature, UGraphStructureVertex*, Vertex,
+                                             const TArray<UGraphStructureEdge*>&, Edges);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGraphStructure_OnBulkAdded_Signature, const TArray<UGraphStructureVertex*>&, Vertices,
+                                             const TArray<UGraphStructureEdge*>&, Edges);
+
+// Result of a single query of a batched query function
+USTRUCT(BlueprintType)
+struct FGraphVertexSet
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	TSet<UGraphStructureVertex*> Vertices;
+};
+
+// Result of a single query of a batched shortest path function, empty if no path was found
+USTRUCT(BlueprintType)
+struct FGraphVertexPath
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<UGraphStructureVertex*> Vertices;
+};
+
 /**
  * 
  */
@@ -27,12 +54,31 @@ class UNREALGRAPHSTRUCTUREPLUGIN_API UGraphStructure : public UObject
 public:
 	UGraphStructure();
 
+	// The attribute tables are not reflected and are serialized along with the element arrays
+	virtual void Serialize(FArchive& Ar) override;
+
+	virtual void PostLoad() override;
+
+	virtual void PostDuplicate(bool bDuplicateForPIE) override;
+
 private:
+	// Vertices and edges are stored densely, the index of each element is its GraphId
 	UPROPERTY()
-	TSet<UGraphStructureVertex*> Vertices;
+	TArray<UGraphStructureVertex*> Vertices;
 
 	UPROPERTY()
-	TSet<UGraphStructureEdge*> Edges;
+	TArray<UGraphStructureEdge*> Edges;
+
+	FGraphAttributeTable VertexAttributes;
+
+	FGraphAttributeTable EdgeAttributes;
+
+	// Vertex whose edges are currently being reported by RemoveVertex
+	UPROPERTY(Transient)
+	UGraphStructureVertex* RemovingVertex = nullptr;
+
+	// Vertex adjacency isn't serialized, it is rebuilt from the edge endpoints after loading or duplicating
+	void RebuildAdjacency();
 
 public:
 	UFUNCTION(BlueprintPure)
@@ -41,6 +87,29 @@ public:
 	UFUNCTION(BlueprintPure)
 	TSet<UGraphStructureEdge*> GetEdges();
 
+	// Elements indexed by their GraphId, without copying
+	TConstArrayView<UGraphStructureVertex*> GetVertexArray() const;
+
+	TConstArrayView<UGraphStructureEdge*> GetEdgeArray() const;
+
+	UFUNCTION(BlueprintPure)
+	int32 GetNumVertices() const;
+
+	UFUNCTION(BlueprintPure)
+	int32 GetNumEdges() const;
+
+	UFUNCTION(BlueprintPure)
+	UGraphStructureVertex* GetVertexById(int32 GraphId) const;
+
+	UFUNCTION(BlueprintPure)
+	UGraphStructureEdge* GetEdgeById(int32 GraphId) const;
+
+	UFUNCTION(BlueprintPure)
+	bool ContainsVertex(const UGraphStructureVertex* Vertex) const;
+
+	UFUNCTION(BlueprintPure)
+	bool ContainsEdge(const UGraphStructureEdge* Edge) const;
+
 	// Construction
 
 	UPROPERTY(BlueprintAssignable)
@@ -49,18 +118,46 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FGraphStructure_OnEdgeAdded_Signature OnEdgeAdded;
 
+	// Vertices store their GraphId, so a vertex can only be part of one graph at a time. Adding a vertex that belongs to another
+	// graph fails, it has to be removed from that graph first
 	UFUNCTION(BlueprintCallable, Category="GraphStructure|Construction")
 	bool AddVertex(UGraphStructureVertex* Vertex);
 
 	UFUNCTION(BlueprintCallable, Category="GraphStructure|Construction")
 	UGraphStructureVertex* AddDefaultVertex();
 
+	// Like vertices an edge can only be part of one graph at a time, its endpoints are expected to be vertices of this graph
 	UFUNCTION(BlueprintCallable, Category="GraphStructure|Construction")
 	bool AddEdge(UGraphStructureEdge* Edge);
 
 	UFUNCTION(BlueprintCallable, Category="GraphStructure|Construction")
 	UGraphStructureEdge* AddDefaultEdgeBetween(UGraphStructureVertex* SourceVertex, UGraphStructureVertex* TargetVertex);
 
+	// Bulk construction, instead of per element events a single OnBulkAdded event is broadcast per call.
+	// Vertices added in bulk receive consecutive GraphIds in the order they are returned.
+	// Every element is still a UObject created inside the graph, object creation makes up most of the remaining cost.
+
+	UPROPERTY(BlueprintAssignable)
+	FGraphStructure_OnBulkAdded_Signature OnBulkAdded;
+
+	// Add NumNewVertices default vertices and default edges between the vertex ids in EdgeEndpoints, which may refer to both existing
+	// and new vertices. New vertices are assigned the ids starting at GetNumVertices(). Nothing is added if any endpoint is invalid.
+	bool AddBulk(int32 NumNewVertices, TConstArrayView<FIntPoint> EdgeEndpoints, TArray<UGraphStructureVertex*>& NewVertices,
+	             TArray<UGraphStructureEdge*>& NewEdges);
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Construction")
+	TArray<UGraphStructureVertex*> AddVerticesBulk(int32 Count);
+
+	// Add default edges between the vertices with the given ids, nothing is added if any id is invalid
+	TArray<UGraphStructureEdge*> AddEdgesBulk(TConstArrayView<FIntPoint> EdgeEndpoints);
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Construction", DisplayName="Add Edges Bulk")
+	TArray<UGraphStructureEdge*> K2_AddEdgesBulk(const TArray<FIntPoint>& EdgeEndpoints);
+
+	// Create a graph with one vertex per list entry, lists are expected to be symmetric so an edge between i and j is only created for
+	// the entry of j in the list of i if j >= i. Returns nullptr if any entry is out of range
+	static UGraphStructure* FromAdjacencyList(TConstArrayView<TArray<int32>> AdjacencyList, UObject* Outer = nullptr);
+
 	// Destruction
 
 	UPROPERTY(BlueprintAssignable)
@@ -69,9 +166,20 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FGraphStructure_OnEdgeRemoved_Signature OnEdgeRemoved;
 
+	// Broadcast once with all edges of a vertex that is being removed, after they have all been detached and before OnEdgeRemoved is
+	// broadcast for each of them. Listeners handling the edges here can skip them in OnEdgeRemoved using IsRemovedWithVertex
+	UPROPERTY(BlueprintAssignable)
+	FGraphStructure_OnVertexEdgesRemoved_Signature OnVertexEdgesRemoved;
+
+	// Edges of the vertex are removed along with it, they are reported through OnVertexEdgesRemoved and then through OnEdgeRemoved one
+	// by one, OnVertexRemoved is broadcast last
 	UFUNCTION(BlueprintCallable, Category="GraphStructure|Destruction")
 	bool RemoveVertex(UGraphStructureVertex* Vertex);
 
+	// Whether the edge is being removed as part of RemoveVertex, i.e. it was already reported through OnVertexEdgesRemoved
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Destruction")
+	bool IsRemovedWithVertex(const UGraphStructureEdge* Edge) const;
+
 	UFUNCTION(BlueprintCallable, Category="GraphStructure|Destruction")
 	bool RemoveEdge(UGraphStructureEdge* Edge);
 
@@ -95,6 +203,117 @@ public:
 	bool BfsShortestPath(UGraphStructureVertex* SourceVertex, UGraphStructureVertex* TargetVertex,
 	                     TArray<UGraphStructureVertex*>& ShortestPath);
 
+	// Batched queries, up to 64 breadth-first searches run at once with one bit per search so searches reaching the same vertex on the
+	// same level share its expansion. Results are returned in the order of the queries
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Query")
+	TArray<FGraphVertexSet> BatchedFindAllConnectedVertices(const TArray<UGraphStructureVertex*>& RootVertices);
+
+	// Find a shortest path from each source vertex to the target vertex at the same index
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Query|ShortestPath")
+	TArray<FGraphVertexPath> BatchedBfsShortestPaths(const TArray<UGraphStructureVertex*>& SourceVertices,
+	                                                 const TArray<UGraphStructureVertex*>& TargetVertices);
+
+	// Weights are read from the edge float attribute WeightAttribute or from the edges Weight if it is None, must not be negative
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Query|ShortestPath")
+	bool DijkstraShortestPath(UGraphStructureVertex* SourceVertex, UGraphStructureVertex* TargetVertex, FName WeightAttribute,
+	                          TArray<UGraphStructureVertex*>& ShortestPath, float& PathLength);
+
+	// Attributes
+
+	FGraphAttributeTable& GetVertexAttributes();
+
+	const FGraphAttributeTable& GetVertexAttributes() const;
+
+	FGraphAttributeTable& GetEdgeAttributes();
+
+	const FGraphAttributeTable& GetEdgeAttributes() const;
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool AddVertexAttribute(FName Name, EGraphAttributeType Type);
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool AddEdgeAttribute(FName Name, EGraphAttributeType Type);
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool RemoveVertexAttribute(FName Name);
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool RemoveEdgeAttribute(FName Name);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	bool GetVertexFloatAttribute(UGraphStructureVertex* Vertex, FName Name, float& Value) const;
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool SetVertexFloatAttribute(UGraphStructureVertex* Vertex, FName Name, float Value);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	bool GetEdgeFloatAttribute(UGraphStructureEdge* Edge, FName Name, float& Value) const;
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool SetEdgeFloatAttribute(UGraphStructureEdge* Edge, FName Name, float Value);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	bool GetVertexIntAttribute(UGraphStructureVertex* Vertex, FName Name, int32& Value) const;
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool SetVertexIntAttribute(UGraphStructureVertex* Vertex, FName Name, int32 Value);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	bool GetEdgeIntAttribute(UGraphStructureEdge* Edge, FName Name, int32& Value) const;
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool SetEdgeIntAttribute(UGraphStructureEdge* Edge, FName Name, int32 Value);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	bool GetVertexVectorAttribute(UGraphStructureVertex* Vertex, FName Name, FVector& Value) const;
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool SetVertexVectorAttribute(UGraphStructureVertex* Vertex, FName Name, FVector Value);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	bool GetEdgeVectorAttribute(UGraphStructureEdge* Edge, FName Name, FVector& Value) const;
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool SetEdgeVectorAttribute(UGraphStructureEdge* Edge, FName Name, FVector Value);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	bool GetVertexBoolAttribute(UGraphStructureVertex* Vertex, FName Name, bool& Value) const;
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool SetVertexBoolAttribute(UGraphStructureVertex* Vertex, FName Name, bool Value);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	bool GetEdgeBoolAttribute(UGraphStructureEdge* Edge, FName Name, bool& Value) const;
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool SetEdgeBoolAttribute(UGraphStructureEdge* Edge, FName Name, bool Value);
+
+	// Bulk attribute operations
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool ScaleVertexFloatAttribute(FName Name, float Factor);
+
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Attributes")
+	bool ScaleEdgeFloatAttribute(FName Name, float Factor);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	double SumVertexFloatAttribute(FName Name) const;
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|Attributes")
+	double SumEdgeFloatAttribute(FName Name) const;
+
+	// Memory
+
+	// Bytes allocated by the graph including its vertex and edge objects, their adjacency and the attribute columns
+	SIZE_T GetAllocatedSize() const;
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	// Release slack left in the element arrays, adjacencies and attribute columns, e.g. after removing many elements
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|Memory")
+	void Shrink();
+
 	// Debugging
 
 	UFUNCTION(BlueprintCallable, Category="GraphStructure|Debugging")
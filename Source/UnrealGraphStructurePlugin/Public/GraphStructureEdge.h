@@ -24,6 +24,18 @@ public:
 	UPROPERTY(BlueprintReadOnly, meta=(ExposeOnSpawn=true))
 	UGraphStructureVertex* Target;
 
+	// Dense index of this edge in its graph, used to address attribute columns. Changes when other edges are removed
+	UPROPERTY(BlueprintReadOnly)
+	int32 GraphId = INDEX_NONE;
+
+	// Maximum amount of flow this edge can carry in either direction, used by flow queries
+	UPROPERTY(BlueprintReadWrite, meta=(ExposeOnSpawn=true))
+	float Capacity = 1.0f;
+
+	// Cost of this edge used by weighted queries such as the minimum spanning forest
+	UPROPERTY(BlueprintReadWrite, meta=(ExposeOnSpawn=true))
+	float Weight = 1.0f;
+
 	// Debugging
 
 	UFUNCTION(BlueprintImplementableEvent, Category="GraphStructure|Debugging")
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GraphVertexAdjacency.h"
 #include "UObject/NoExportTypes.h"
 #include "GraphStructureVertex.generated.h"
 
@@ -18,8 +19,18 @@ class UNREALGRAPHSTRUCTUREPLUGIN_API UGraphStructureVertex : public UObject
 public:
 	UGraphStructureVertex();
 
+	// Not a UPROPERTY since it uses inline storage, edges are reported to the garbage collector in AddReferencedObjects
+	FGraphVertexAdjacency Adjacency;
+
+	// Dense index of this vertex in its graph, used to address attribute columns. Changes when other vertices are removed
 	UPROPERTY(BlueprintReadOnly)
-	TSet<UGraphStructureEdge*> Edges;
+	int32 GraphId = INDEX_NONE;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	// Copy of the edges as a set, C++ code should iterate Adjacency directly
+	UFUNCTION(BlueprintPure)
+	TSet<UGraphStructureEdge*> GetEdges() const;
 
 	// Debugging
 
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FReferenceCollector;
+class UGraphStructureEdge;
+class UObject;
+
+/**
+ * Edges of a vertex. Most vertices only have a handful of edges, so they are kept in an inline array and found by a linear scan.
+ * Once a vertex exceeds HashThreshold edges an index map is built to keep lookups and removals constant time for hubs.
+ * Removal swaps in the last edge, the order of edges is not stable.
+ */
+class UNREALGRAPHSTRUCTUREPLUGIN_API FGraphVertexAdjacency
+{
+	static constexpr int32 InlineEdges = 4;
+
+	static constexpr int32 HashThreshold = 16;
+
+	TArray<UGraphStructureEdge*, TInlineAllocator<InlineEdges>> Edges;
+
+	// Index of each edge in Edges, only allocated for hubs above HashThreshold so small vertices only pay for the pointer
+	TUniquePtr<TMap<UGraphStructureEdge*, int32>> EdgeIndices;
+
+	int32 Find(const UGraphStructureEdge* Edge) const;
+
+	void BuildEdgeIndices();
+
+public:
+	// Returns false if the edge is already contained
+	bool Add(UGraphStructureEdge* Edge);
+
+	// Add an edge known not to be contained yet, skips the lookup Add does. Used when building adjacency in bulk
+	void AddUnchecked(UGraphStructureEdge* Edge);
+
+	bool Remove(const UGraphStructureEdge* Edge);
+
+	bool Contains(const UGraphStructureEdge* Edge) const;
+
+	int32 Num() const
+	{
+		return Edges.Num();
+	}
+
+	bool IsEmpty() const
+	{
+		return Edges.IsEmpty();
+	}
+
+	TArray<UGraphStructureEdge*> Array() const;
+
+	void Empty();
+
+	void Reserve(int32 Number);
+
+	// Release slack left behind by removals, drops the index map if the vertex is no hub anymore
+	void Shrink();
+
+	// Heap memory used by the edges and, for hubs, the index map including the map itself
+	SIZE_T GetAllocatedSize() const;
+
+	void AddReferencedObjects(FReferenceCollector& Collector, const UObject* Referencer);
+
+	// Ranged-for support, the adjacency must not be modified while iterating
+	UGraphStructureEdge* const* begin() const
+	{
+		return Edges.GetData();
+	}
+
+	UGraphStructureEdge* const* end() const
+	{
+		return Edges.GetData() + Edges.Num();
+	}
+};
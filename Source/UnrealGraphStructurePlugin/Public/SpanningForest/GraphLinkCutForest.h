@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Link-cut trees over integer node ids, every node carries a value and paths can be queried for the node with the largest value.
+ * All operations run in amortized O(log n).
+ */
+class UNREALGRAPHSTRUCTUREPLUGIN_API FGraphLinkCutForest
+{
+	struct FNode
+	{
+		int32 Children[2] = {INDEX_NONE, INDEX_NONE};
+		int32 Parent = INDEX_NONE;
+		int32 MaxNode = INDEX_NONE;
+		float Value = 0.0f;
+		bool bFlipped = false;
+	};
+
+	TArray<FNode> Nodes;
+	TArray<int32> FreeNodes;
+
+	bool IsSplayRoot(int32 Node) const;
+	void UpdateMax(int32 Node);
+	void PushFlip(int32 Node);
+	void Rotate(int32 Node);
+	void Splay(int32 Node);
+	void Access(int32 Node);
+	void MakeRoot(int32 Node);
+	int32 FindRoot(int32 Node);
+
+public:
+	// Add an isolated node, ids of removed nodes are reused
+	int32 AddNode(float Value);
+
+	// Remove an isolated node
+	void RemoveNode(int32 Node);
+
+	bool Connected(int32 A, int32 B);
+
+	// Connect the trees of A and B by an edge between A and B, they must not be connected yet
+	void Link(int32 A, int32 B);
+
+	// Remove the edge between A and B, which must exist
+	void Cut(int32 A, int32 B);
+
+	// Node with the largest value on the path between A and B, which must be connected
+	int32 PathMaxNode(int32 A, int32 B);
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+};
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GraphLinkCutForest.h"
+#include "GraphStructure.h"
+#include "UObject/NoExportTypes.h"
+#include "GraphSpanningForestMonitor.generated.h"
+
+/**
+ * Maintains a minimum spanning forest of a graph using the Weight of its edges.
+ * Inserted edges replace the heaviest forest edge on the path between their endpoints if they are lighter, found via path-max
+ * queries on link-cut trees. Removed forest edges are replaced by the lightest edge reconnecting the smaller of the two trees.
+ * Edge weights are read when the edge is added to the graph, later changes to Weight are not picked up.
+ */
+UCLASS(BlueprintType)
+class UNREALGRAPHSTRUCTUREPLUGIN_API UGraphSpanningForestMonitor : public UObject
+{
+	GENERATED_BODY()
+
+	bool SetupCompleted = false;
+
+	UPROPERTY()
+	UGraphStructure* Graph;
+
+	// Link-cut trees representing the forest, vertices and forest edges are both nodes so edges can carry their weight
+	FGraphLinkCutForest LinkCutForest;
+
+	UPROPERTY()
+	TMap<UGraphStructureVertex*, int32> VertexNodes;
+
+	UPROPERTY()
+	TMap<UGraphStructureEdge*, int32> ForestEdgeNodes;
+
+	// Forest edge represented by each link-cut node, nullptr for vertex nodes
+	TArray<UGraphStructureEdge*> NodeEdges;
+
+	// Weight of every edge in the graph at the time it was added
+	UPROPERTY()
+	TMap<UGraphStructureEdge*, float> EdgeWeights;
+
+	double TotalWeight = 0.0;
+
+	void InsertEdge(UGraphStructureEdge* Edge);
+
+	void LinkForestEdge(UGraphStructureEdge* Edge);
+
+	void CutForestEdge(UGraphStructureEdge* Edge);
+
+	// Find the lightest edge reconnecting the two trees of Source and Target after their forest edge has been cut
+	UGraphStructureEdge* FindReplacementEdge(UGraphStructureVertex* Source, UGraphStructureVertex* Target) const;
+
+	// Functions for binding to graph delegates
+
+	UFUNCTION()
+	void GraphStructure_VertexAdded(UGraphStructureVertex* Vertex);
+
+	UFUNCTION()
+	void GraphStructure_VertexRemoved(UGraphStructureVertex* Vertex);
+
+	UFUNCTION()
+	void GraphStructure_EdgeAdded(UGraphStructureEdge* Edge);
+
+	UFUNCTION()
+	void GraphStructure_EdgeRemoved(UGraphStructureEdge* Edge);
+
+	UFUNCTION()
+	void GraphStructure_VertexEdgesRemoved(UGraphStructureVertex* Vertex, const TArray<UGraphStructureEdge*>& Edges);
+
+	UFUNCTION()
+	void GraphStructure_BulkAdded(const TArray<UGraphStructureVertex*>& NewVertices, const TArray<UGraphStructureEdge*>& NewEdges);
+
+public:
+	UFUNCTION(BlueprintCallable, Category="GraphStructure|SpanningForest")
+	void Setup(UGraphStructure* MonitorGraph);
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|SpanningForest")
+	TSet<UGraphStructureEdge*> GetForestEdges() const;
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|SpanningForest")
+	bool IsForestEdge(UGraphStructureEdge* Edge) const;
+
+	UFUNCTION(BlueprintPure, Category="GraphStructure|SpanningForest")
+	float GetTotalWeight() const;
+
+	// Memory
+
+	SIZE_T GetAllocatedSize() const;
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+};